@@ -0,0 +1,167 @@
+#define _GNU_SOURCE// posix_openpt and ptsname
+
+#include "../../src/game_data/map/map_generator.h"
+#include "../../src/game_data/map/map_revealer.h"
+#include "../../src/io/output/common/common_output.h"
+#include "../../src/io/output/frame/frame_buffer.h"
+#include "../../src/io/output/frame/render_thread.h"
+#include "../../src/io/output/specific/map_output.h"
+#include "../../src/io/output/specific/minimap_output.h"
+#include "../../termbox2/termbox2.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define POOL_SIZE (16 * 1024 * 1024)
+#define VIEW_WIDTH 61
+#define VIEW_HEIGHT 25
+#define FRAMES 2000
+#define SCREEN_WIDTH 120
+#define SCREEN_HEIGHT 40
+#define LARGE_MAP_WIDTH 255
+#define LARGE_MAP_HEIGHT 127
+#define MINIMAP_WIDTH 24
+#define MINIMAP_HEIGHT 16
+
+double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000.0 + ts.tv_nsec;
+}
+
+// discards everything termbox writes to the pseudo terminal, so tb_present never blocks
+void* drain_terminal(void* arg) {
+    const int master = *(int*) arg;
+    char buffer[4096];
+    while (read(master, buffer, sizeof(buffer)) > 0) {}
+    return NULL;
+}
+
+// termbox runs on a pseudo terminal, so the benchmark doesn't need a real one
+int init_terminal(int* master) {
+    *master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (*master < 0 || grantpt(*master) != 0 || unlockpt(*master) != 0) return 1;
+    const struct winsize size = {.ws_row = SCREEN_HEIGHT, .ws_col = SCREEN_WIDTH};
+    ioctl(*master, TIOCSWINSZ, &size);
+
+    const int slave = open(ptsname(*master), O_RDWR | O_NOCTTY);
+    if (slave < 0) return 1;
+    pthread_t drain;
+    pthread_create(&drain, NULL, drain_terminal, master);
+    setenv("TERM", "xterm", 0);
+    if (tb_init_fd(slave) != TB_OK) return 1;
+    return init_frame_buffer(SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+int main(void) {
+    int master;
+    if (init_terminal(&master) != 0) {
+        fprintf(stderr, "failed to initialize termbox on a pseudo terminal\n");
+        return 1;
+    }
+    srand(1234);
+    memory_pool_t* pool = init_memory_pool(POOL_SIZE);
+    map_t* map = memory_pool_alloc(pool, sizeof(map_t));
+    map->floor_nr = 1;
+    map->width = VIEW_WIDTH;
+    map->height = VIEW_HEIGHT;
+    map->enemy_count = 4;
+    generate_map(pool, map, 1);
+    for (int x = 0; x < map->width; x++) {
+        for (int y = 0; y < map->height; y++) {
+            reveal_tile(map, x, y);
+        }
+    }
+    map_render_cache_t* cache = create_map_render_cache();
+    const double tiles = (double) FRAMES * VIEW_WIDTH * VIEW_HEIGHT;
+
+    // drawing into the back buffer only, every tile is a lookup in the tile cell table
+    begin_frame();
+    double start = now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        invalidate_map_render_cache(cache);
+        render_map_view(cache, 5, 4, map, 0, 0, VIEW_WIDTH, VIEW_HEIGHT);
+    }
+    const double full_ns = (now_ns() - start) / tiles;
+
+    start = now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        render_map_view(cache, 5, 4, map, 0, 0, VIEW_WIDTH, VIEW_HEIGHT);
+    }
+    const double static_ns = (now_ns() - start) / tiles;
+    end_frame();
+
+    // time the game logic spends per frame on handing a changed frame to the terminal
+    start = now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        begin_frame();
+        invalidate_map_render_cache(cache);
+        render_map_view(cache, 5, 4, map, 0, 0, VIEW_WIDTH, VIEW_HEIGHT);
+        end_frame();
+    }
+    const double sync_us = (now_ns() - start) / FRAMES / 1000.0;
+
+    start_render_thread();
+    start = now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        begin_frame();
+        invalidate_map_render_cache(cache);
+        render_map_view(cache, 5, 4, map, 0, 0, VIEW_WIDTH, VIEW_HEIGHT);
+        end_frame();
+    }
+    const double threaded_us = (now_ns() - start) / FRAMES / 1000.0;
+    stop_render_thread();
+
+    // a large floor explored step by step, the minimap is resampled completely or only where tiles were revealed
+    map_t* large_map = memory_pool_alloc(pool, sizeof(map_t));
+    large_map->floor_nr = 1;
+    large_map->width = LARGE_MAP_WIDTH;
+    large_map->height = LARGE_MAP_HEIGHT;
+    large_map->enemy_count = 4;
+    generate_map(pool, large_map, 1);
+    minimap_t* minimap = create_minimap();
+    begin_frame();
+    start = now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        large_map->player_pos = (vector2d_t) {1 + 2 * (rand() % (LARGE_MAP_WIDTH / 2)),
+                                              1 + 2 * (rand() % (LARGE_MAP_HEIGHT / 2))};
+        reveal_map_step(large_map, (vector2d_t) {1, 0}, 3);
+        minimap->map = NULL;// forces sampling the whole map
+        render_minimap(minimap, 90, 10, large_map, MINIMAP_WIDTH, MINIMAP_HEIGHT);
+    }
+    const double minimap_full_us = (now_ns() - start) / FRAMES / 1000.0;
+
+    start = now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        large_map->player_pos = (vector2d_t) {1 + 2 * (rand() % (LARGE_MAP_WIDTH / 2)),
+                                              1 + 2 * (rand() % (LARGE_MAP_HEIGHT / 2))};
+        reveal_map_step(large_map, (vector2d_t) {1, 0}, 3);
+        render_minimap(minimap, 90, 10, large_map, MINIMAP_WIDTH, MINIMAP_HEIGHT);
+    }
+    const double minimap_events_us = (now_ns() - start) / FRAMES / 1000.0;
+    end_frame();
+
+    shutdown_frame_buffer();
+    tb_shutdown();
+    printf("%dx%d view, %d frames\n", VIEW_WIDTH, VIEW_HEIGHT, FRAMES);
+    printf("render_map_view, full      %8.2f ns/tile\n", full_ns);
+    printf("render_map_view, static    %8.2f ns/tile (%.2fx)\n", static_ns, full_ns / static_ns);
+    printf("frame, written directly    %8.2f us/frame\n", sync_us);
+    printf("frame, render thread       %8.2f us/frame (%.2fx)\n", threaded_us, sync_us / threaded_us);
+    printf("%dx%d floor, %dx%d minimap\n", LARGE_MAP_WIDTH, LARGE_MAP_HEIGHT, MINIMAP_WIDTH, MINIMAP_HEIGHT);
+    printf("minimap, resampled         %8.2f us/frame\n", minimap_full_us);
+    printf("minimap, reveal events     %8.2f us/frame (%.2fx)\n", minimap_events_us,
+           minimap_full_us / minimap_events_us);
+
+    destroy_minimap(minimap);
+    destroy_map(pool, large_map);
+    destroy_map_render_cache(cache);
+    destroy_map(pool, map);
+    shutdown_memory_pool(pool);
+    return 0;
+}
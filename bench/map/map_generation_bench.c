@@ -0,0 +1,130 @@
+#include "../../src/game_data/map/map_batch.h"
+#include "../../src/game_data/map/map_connectivity.h"
+#include "../../src/game_data/map/map_generator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define POOL_SIZE (128 * 1024 * 1024)
+#define REPETITIONS 5
+
+double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+double bench_sequential(const memory_pool_t* pool, const int count, const int width, const int height) {
+    map_t* maps[count];
+
+    const double start = now_ms();
+    for (int i = 0; i < count; i++) {
+        maps[i] = memory_pool_alloc(pool, sizeof(map_t));
+        maps[i]->floor_nr = i + 1;
+        maps[i]->width = width;
+        maps[i]->height = height;
+        maps[i]->enemy_count = 4;
+        if (generate_map(pool, maps[i], i != count - 1) != 0) {
+            fprintf(stderr, "sequential generation failed\n");
+            exit(1);
+        }
+    }
+    const double elapsed = now_ms() - start;
+
+    for (int i = 0; i < count; i++) {
+        destroy_map(pool, maps[i]);
+    }
+    return elapsed;
+}
+
+double bench_batch(const memory_pool_t* pool, const int count, const int width, const int height, const int threads) {
+    const map_t map_template = {.floor_nr = 1, .width = width, .height = height, .enemy_count = 4};
+
+    const double start = now_ms();
+    map_batch_t* batch = generate_map_batch(pool, &map_template, count, 0, threads);
+    const double elapsed = now_ms() - start;
+
+    if (batch == NULL) {
+        fprintf(stderr, "batch generation failed\n");
+        exit(1);
+    }
+    destroy_map_batch(pool, batch);
+    return elapsed;
+}
+
+void run_case(const memory_pool_t* pool, const int count, const int width, const int height) {
+    const int cores = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+    double sequential = 0;
+    double batch = 0;
+    double parallel = 0;
+    for (int i = 0; i < REPETITIONS; i++) {
+        sequential += bench_sequential(pool, count, width, height);
+        batch += bench_batch(pool, count, width, height, 1);
+        parallel += bench_batch(pool, count, width, height, cores);
+    }
+    sequential /= REPETITIONS;
+    batch /= REPETITIONS;
+    parallel /= REPETITIONS;
+
+    printf("%3d floors %4dx%-4d | sequential %8.3f ms | batch %8.3f ms | batch %2d threads %8.3f ms (%.2fx)\n",
+           count, width, height, sequential, batch, cores, parallel, sequential / parallel);
+}
+
+void run_generator_case(const memory_pool_t* pool, const generator_type_t type, const int count, const int width,
+                        const int height) {
+    map_t map = {.floor_nr = 1, .width = width, .height = height, .enemy_count = 4};
+    normalize_map_dimensions(&map);
+    map.hidden_tiles = memory_pool_alloc(pool, map.width * map.height * sizeof(map_tile_t));
+    map.revealed_mask = memory_pool_alloc(pool, MASK_WORDS(map.width * map.height) * sizeof(uint64_t));
+    map.chunks = NULL;
+
+    // the tiles are reused, so only the generator itself is measured
+    const double start = now_ms();
+    for (int i = 0; i < count; i++) {
+        if (generate_map_tiles_with(&map, 1, type) != 0) {
+            fprintf(stderr, "%s generation failed\n", get_map_generator(type)->name);
+            exit(1);
+        }
+    }
+    const double elapsed = now_ms() - start;
+
+    // the validation already runs inside the generation, here it's measured on its own
+    const double validation_start = now_ms();
+    for (int i = 0; i < count; i++) {
+        if (count_unreachable_tiles(&map) != 0) {
+            fprintf(stderr, "%s generated unreachable tiles\n", get_map_generator(type)->name);
+            exit(1);
+        }
+    }
+    const double validation = (now_ms() - validation_start) * 1000.0 / count;
+
+    printf("%-6s %4dx%-4d | %8.3f ms per floor | %10.1f floors/s | %7.2f Mtiles/s | validation %8.1f us\n",
+           get_map_generator(type)->name, map.width, map.height, elapsed / count, count * 1000.0 / elapsed,
+           (double) count * map.width * map.height / (elapsed * 1000.0), validation);
+
+    memory_pool_free(pool, map.hidden_tiles);
+    memory_pool_free(pool, map.revealed_mask);
+}
+
+int main(void) {
+    srand(1234);
+    memory_pool_t* pool = init_memory_pool(POOL_SIZE);
+    if (pool == NULL) return 1;
+
+    run_case(pool, 5, 39, 19);
+    run_case(pool, 64, 39, 19);
+    run_case(pool, 16, 127, 127);
+    run_case(pool, 16, 255, 255);
+
+    for (int type = 0; type < MAX_GENERATOR_TYPES; type++) {
+        run_generator_case(pool, type, 256, 39, 19);
+        run_generator_case(pool, type, 32, 127, 127);
+        run_generator_case(pool, type, 8, 255, 255);
+    }
+
+    shutdown_memory_pool(pool);
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "../../src/game_data/map/map_flow_field.h"
+#include "../../src/game_data/map/map_generator.h"
+#include "../../src/game_data/map/map_pathfinder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define POOL_SIZE (64 * 1024 * 1024)
+#define MAP_SIZE 501
+#define QUERIES 2000
+#define VERIFIED_QUERIES 50
+
+double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000.0 + ts.tv_nsec;
+}
+
+vector2d_t random_floor(const map_t* map) {
+    vector2d_t pos;
+    do {
+        pos = (vector2d_t) {rand() % map->width, rand() % map->height};
+    } while (get_hidden_tile(map, pos.dx, pos.dy) == WALL);
+    return pos;
+}
+
+// compares the path lengths with the bfs distances of a flow field
+void verify_paths(const memory_pool_t* pool, map_t* map, pathfinder_t* pathfinder,
+                  const vector2d_t* starts, const vector2d_t* goals) {
+    flow_field_t* field = create_flow_field(pool);
+    for (int i = 0; i < VERIFIED_QUERIES; i++) {
+        const vector2d_t* steps;
+        const int length = find_path(pathfinder, map, starts[i], goals[i], 0, &steps);
+        update_flow_field(field, map, goals[i]);
+        if (length != get_flow_distance(field, starts[i].dx, starts[i].dy)) {
+            fprintf(stderr, "path %d has %d steps, bfs needs %d\n", i, length,
+                    get_flow_distance(field, starts[i].dx, starts[i].dy));
+            exit(1);
+        }
+    }
+    destroy_flow_field(field);
+}
+
+void run_map(const memory_pool_t* pool, const generator_type_t type) {
+    map_t map = {.floor_nr = 1, .width = MAP_SIZE, .height = MAP_SIZE, .enemy_count = 4};
+    normalize_map_dimensions(&map);
+    map.hidden_tiles = memory_pool_alloc(pool, map.width * map.height * sizeof(map_tile_t));
+    map.revealed_mask = memory_pool_alloc(pool, MASK_WORDS(map.width * map.height) * sizeof(uint64_t));
+    map.chunks = NULL;
+    map.packed_tiles = NULL;
+    if (generate_map_tiles_with(&map, 1, type) != 0) {
+        fprintf(stderr, "map generation failed\n");
+        exit(1);
+    }
+
+    static vector2d_t starts[QUERIES];
+    static vector2d_t goals[QUERIES];
+    for (int i = 0; i < QUERIES; i++) {
+        starts[i] = random_floor(&map);
+        goals[i] = random_floor(&map);
+    }
+
+    pathfinder_t* pathfinder = create_pathfinder(pool);
+    verify_paths(pool, &map, pathfinder, starts, goals);
+
+    // every query misses the cache, as there are more distinct queries than slots
+    long total_steps = 0;
+    double start = now_ns();
+    for (int i = 0; i < QUERIES; i++) {
+        const vector2d_t* steps;
+        total_steps += find_path(pathfinder, &map, starts[i], goals[i], 0, &steps);
+    }
+    const double search_ns = (now_ns() - start) / QUERIES;
+
+    // the same query again, answered from the cache
+    const int repeats = QUERIES * 100;
+    start = now_ns();
+    for (int i = 0; i < repeats; i++) {
+        const vector2d_t* steps;
+        find_path(pathfinder, &map, starts[0], goals[0], 0, &steps);
+    }
+    const double cached_ns = (now_ns() - start) / repeats;
+
+    // walking along a path with a query per step, like an enemy chasing a fixed target
+    const vector2d_t* steps;
+    const int length = find_path(pathfinder, &map, starts[1], goals[1], 0, &steps);
+    vector2d_t pos = starts[1];
+    start = now_ns();
+    for (int i = 0; i < length; i++) {
+        const vector2d_t* rest;
+        find_path(pathfinder, &map, pos, goals[1], 0, &rest);
+        pos = rest[0];
+    }
+    const double follow_ns = length > 0 ? (now_ns() - start) / length : 0;
+
+    printf("%s %dx%d, %d queries with %.1f steps on average\n", get_map_generator(type)->name, map.width,
+           map.height, QUERIES, (double) total_steps / QUERIES);
+    printf("a* search %10.1f ns/query %10.0f queries/s\n", search_ns, 1e9 / search_ns);
+    printf("cached    %10.1f ns/query %10.0f queries/s\n", cached_ns, 1e9 / cached_ns);
+    printf("following %10.1f ns/step  over %d steps\n", follow_ns, length);
+
+    destroy_pathfinder(pathfinder);
+    memory_pool_free(pool, map.hidden_tiles);
+    memory_pool_free(pool, map.revealed_mask);
+}
+
+int main(void) {
+    srand(1234);
+    memory_pool_t* pool = init_memory_pool(POOL_SIZE);
+    if (pool == NULL) return 1;
+
+    run_map(pool, MAZE_GENERATOR);
+    run_map(pool, CAVE_GENERATOR);
+
+    shutdown_memory_pool(pool);
+    return 0;
+}
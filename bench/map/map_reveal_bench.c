@@ -0,0 +1,156 @@
+#include "../../src/game_data/map/map_generator.h"
+#include "../../src/game_data/map/map_revealer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define POOL_SIZE (16 * 1024 * 1024)
+#define MAP_SIZE 255
+#define POSITIONS 2000
+#define WALK_STEPS 200000
+
+typedef int (*revealer_t)(const map_t* map, int light_radius);
+
+double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000.0 + ts.tv_nsec;
+}
+
+void hide_around(const map_t* map, const vector2d_t pos, const int radius) {
+    for (int x = pos.dx - radius; x <= pos.dx + radius; x++) {
+        for (int y = pos.dy - radius; y <= pos.dy + radius; y++) {
+            hide_tile(map, x, y);
+        }
+    }
+}
+
+int count_revealed(const map_t* map, const vector2d_t pos, const int radius) {
+    int count = 0;
+    for (int x = pos.dx - radius; x <= pos.dx + radius; x++) {
+        for (int y = pos.dy - radius; y <= pos.dy + radius; y++) {
+            count += get_revealed_tile(map, x, y) != HIDDEN;
+        }
+    }
+    return count;
+}
+
+void run_revealer(map_t* map, const vector2d_t* positions, const revealer_t revealer, const int radius,
+                  double* ns_per_call, double* tiles_per_call) {
+    double elapsed = 0;
+    long revealed = 0;
+    for (int i = 0; i < POSITIONS; i++) {
+        // every call starts on an unrevealed area, the reset itself isn't measured
+        hide_around(map, positions[i], radius + 1);
+        map->player_pos = positions[i];
+
+        const double start = now_ns();
+        revealer(map, radius);
+        elapsed += now_ns() - start;
+
+        revealed += count_revealed(map, positions[i], radius + 1);
+    }
+    *ns_per_call = elapsed / POSITIONS;
+    *tiles_per_call = (double) revealed / POSITIONS;
+}
+
+void hide_map(const map_t* map) {
+    for (int x = 0; x < map->width; x++) {
+        for (int y = 0; y < map->height; y++) {
+            hide_tile(map, x, y);
+        }
+    }
+}
+
+// random walk over the floor, revealing after every step either fully or incrementally
+double run_walk(map_t* map, const int incremental, const unsigned int seed, long* revealed) {
+    const vector2d_t steps[4] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    srand(seed);
+    hide_map(map);
+    forget_lit_origins(map);
+    map->player_pos = map->entry_pos;
+    reveal_map_shadowcast(map, 3);
+
+    double elapsed = 0;
+    for (int i = 0; i < WALK_STEPS; i++) {
+        const vector2d_t step = steps[rand() % 4];
+        const int x = map->player_pos.dx + step.dx;
+        const int y = map->player_pos.dy + step.dy;
+        if (get_hidden_tile(map, x, y) == WALL) continue;
+        map->player_pos = (vector2d_t) {x, y};
+
+        const double start = now_ns();
+        if (incremental) {
+            reveal_map_step(map, step, 3);
+        } else {
+            reveal_map_shadowcast(map, 3);
+        }
+        elapsed += now_ns() - start;
+    }
+
+    *revealed = 0;
+    for (int x = 0; x < map->width; x++) {
+        for (int y = 0; y < map->height; y++) {
+            *revealed += get_revealed_tile(map, x, y) != HIDDEN;
+        }
+    }
+    return elapsed / WALK_STEPS;
+}
+
+void run_map(const memory_pool_t* pool, const generator_type_t type) {
+    map_t map = {.floor_nr = 1, .width = MAP_SIZE, .height = MAP_SIZE, .enemy_count = 4};
+    normalize_map_dimensions(&map);
+    map.hidden_tiles = memory_pool_alloc(pool, map.width * map.height * sizeof(map_tile_t));
+    map.revealed_mask = memory_pool_alloc(pool, MASK_WORDS(map.width * map.height) * sizeof(uint64_t));
+    map.chunks = NULL;
+    map.packed_tiles = NULL;
+    forget_lit_origins(&map);
+    if (generate_map_tiles_with(&map, 1, type) != 0) {
+        fprintf(stderr, "map generation failed\n");
+        exit(1);
+    }
+
+    // the same random floor positions for both revealers
+    vector2d_t positions[POSITIONS];
+    for (int i = 0; i < POSITIONS; i++) {
+        do {
+            positions[i] = (vector2d_t) {rand() % map.width, rand() % map.height};
+        } while (get_hidden_tile(&map, positions[i].dx, positions[i].dy) == WALL);
+    }
+
+    printf("%s %dx%d\n", get_map_generator(type)->name, map.width, map.height);
+    printf("radius | reveal_map ns/call tiles | shadowcast ns/call tiles | speedup\n");
+    for (int radius = 3; radius <= 30; radius += radius < 10 ? 1 : 5) {
+        double fan_ns;
+        double fan_tiles;
+        double cast_ns;
+        double cast_tiles;
+        run_revealer(&map, positions, reveal_map, radius, &fan_ns, &fan_tiles);
+        run_revealer(&map, positions, reveal_map_shadowcast, radius, &cast_ns, &cast_tiles);
+        printf("%6d | %18.1f %5.1f | %18.1f %5.1f | %6.2fx\n", radius, fan_ns, fan_tiles, cast_ns, cast_tiles,
+               fan_ns / cast_ns);
+    }
+
+    long full_revealed;
+    long step_revealed;
+    const double full_ns = run_walk(&map, 0, 42, &full_revealed);
+    const double step_ns = run_walk(&map, 1, 42, &step_revealed);
+    printf("walk of %d steps | shadowcast %.1f ns/step | reveal_map_step %.1f ns/step | %.2fx | revealed %ld / %ld\n",
+           WALK_STEPS, full_ns, step_ns, full_ns / step_ns, full_revealed, step_revealed);
+
+    memory_pool_free(pool, map.hidden_tiles);
+    memory_pool_free(pool, map.revealed_mask);
+}
+
+int main(void) {
+    srand(1234);
+    memory_pool_t* pool = init_memory_pool(POOL_SIZE);
+    if (pool == NULL) return 1;
+
+    run_map(pool, MAZE_GENERATOR);
+    run_map(pool, CAVE_GENERATOR);
+
+    shutdown_memory_pool(pool);
+    return 0;
+}
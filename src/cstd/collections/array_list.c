@@ -77,9 +77,7 @@ int array_list_add(void* self, const void* element) {
         void* new_elements = realloc(list->elements, new_capacity);
         if (new_elements == NULL) return -1;// Error: memory allocation failed
 
-        // copy the old elements to the new memory location
-        memcpy(new_elements, list->elements, list->allocated);
-
+        // realloc already moved the old elements, the old pointer must not be read anymore
         list->elements = new_elements;
         list->allocated = new_capacity;
     }
@@ -1,6 +1,7 @@
 #include "game.h"
 
 #include "game_data/character/enemy_generator.h"
+#include "game_data/map/map_compression.h"
 #include "game_data/map/map_generator.h"
 #include "game_data/map/map_revealer.h"
 #include "game_modes/character/character_creation_mode.h"
@@ -12,47 +13,84 @@
 #include "game_modes/menus/main_menu_mode.h"
 #include "game_modes/menus/save_game_mode.h"
 #include "game_modes/menus/title_screen_mode.h"
+#include "helper/time_helper.h"
 #include "io/input/input_handler.h"
+#include "io/output/common/common_output.h"
+#include "io/output/frame/render_thread.h"
+#include "io/output/specific/perf_hud.h"
 #include "logger/logger.h"
 
 #define FRAMES_PER_SECONDS 26.0
+#define TICK_NS ((long long) (1000000000.0 / FRAMES_PER_SECONDS))
 
-#define MAX_MAP_COUNT 5
 #define MAP_HEIGHT 19
 #define MAP_WIDTH 39
 #define ENEMY_COUNT 4
 
 memory_pool_t* global_memory_pool = NULL;
 
+/**
+ * Makes the floor with the given index the active floor. The tiles of the previously active floor are
+ * packed, since only the active floor is accessed, and the tiles of the new floor are unpacked.
+ *
+ * @param pool The memory pool of the maps.
+ * @param game_state The game state containing the floor cache.
+ * @param new_index The index of the new active floor.
+ * @return The new active floor, or NULL if it couldn't be read or unpacked.
+ */
+map_t* change_active_floor(const memory_pool_t* pool, game_state_t* game_state, int new_index);
+
+/**
+ * Sleeps until the start of the next tick. The ticks are scheduled from a fixed start time, so the time
+ * spent in the game logic doesn't stretch the tick. If the logic fell behind by more than a tick,
+ * the schedule restarts from now instead of running the missed ticks back to back.
+ *
+ * @param next_tick The start time of the next tick in nanoseconds, advanced by one tick.
+ */
+void wait_for_next_tick(long long* next_tick);
+
 void start_game_loop(memory_pool_t* used_pool) {
     global_memory_pool = used_pool;
 
-    //allocate maps in the memory pool, with max number of maps
-    map_t** maps = memory_pool_alloc(used_pool, MAX_MAP_COUNT * sizeof(map_t*));
-    for (int i = 0; i < MAX_MAP_COUNT; i++) {
-        maps[i] = NULL;
-    }
+    //the dungeon has no depth limit, only the recently used floors are kept in memory
+    floor_cache_t* floors = create_floor_cache(used_pool);
 
     bool running = true;
     state_t current = TITLE_SCREEN;
     state_t return_to = TITLE_SCREEN;
 
     game_state_t game_state = {
-            .max_floors = 0,       // on which floor the player is 1 - 5, 0 - no floor
+            .max_floors = 0,       // number of generated floors, 0 - no floor
             .active_map_index = -1,//-1 means no map is active
-            .maps = maps,
+            .floors = floors,
             .player = create_empty_character(0)};
 
+    if (floors == NULL) {
+        log_msg(ERROR, "Game", "Failed to create floor cache");
+        running = false;
+    }
     if (game_state.player == NULL) {
         log_msg(ERROR, "Game", "Failed to create empty character");
         running = false;
     }
     Character* enemy = NULL;
+    long long next_tick = monotonic_ns() + TICK_NS;
 
     while (running) {
-        usleep((unsigned int) (1.0 / FRAMES_PER_SECONDS * 1000000.0));// wait for 1 frame
-        const input_t input = get_next_input();
+        // the terminal is written by the render thread, so a tick only waits for the game logic
+        wait_for_next_tick(&next_tick);
+        const long long tick_start = monotonic_ns();
+        input_t input = get_next_input();
+        if (input != NO_INPUT) mark_frame_input(get_last_input_time());
+        if (input == F3) {
+            // the HUD is available in every mode, so the modes never see the toggle key
+            toggle_perf_hud();
+            input = NO_INPUT;
+        }
 
+        //everything the modes print is flushed to the terminal at once
+        begin_frame();
+        const long long update_start = monotonic_ns();
         switch (current) {
             case TITLE_SCREEN:
                 current = update_title_screen(input);
@@ -63,30 +101,42 @@ void start_game_loop(memory_pool_t* used_pool) {
                 }
                 break;
             case GENERATE_MAP: {
-                if (game_state.max_floors == MAX_MAP_COUNT) break;// last floor reached, can't generate more maps
+                if (game_state.active_map_index >= 0 &&
+                    pack_map(used_pool, get_floor(floors, game_state.active_map_index)) != 0) {
+                    log_msg(WARNING, "Game", "Failed to pack floor %d", game_state.active_map_index);
+                }
 
-                game_state.active_map_index += 1;
-                game_state.max_floors += 1;
-                maps[game_state.active_map_index] = memory_pool_alloc(used_pool, sizeof(map_t));
-                if (maps[game_state.active_map_index] == NULL) {
+                map_t* map = memory_pool_alloc(used_pool, sizeof(map_t));
+                if (map == NULL) {
                     log_msg(ERROR, "Game", "Failed to allocate memory for map");
                     running = false;
+                    break;
                 }
                 //initialize the map
-                maps[game_state.active_map_index]->floor_nr = game_state.max_floors;
-                maps[game_state.active_map_index]->width = MAP_WIDTH;
-                maps[game_state.active_map_index]->height = MAP_HEIGHT;
-                maps[game_state.active_map_index]->enemy_count = ENEMY_COUNT;
+                map->floor_nr = game_state.max_floors + 1;
+                map->width = MAP_WIDTH;
+                map->height = MAP_HEIGHT;
+                map->enemy_count = ENEMY_COUNT;
 
-                if (generate_map(used_pool, maps[game_state.active_map_index],
-                                 game_state.max_floors != MAX_MAP_COUNT) != 0) {
+                if (generate_map(used_pool, map, 1) != 0) {
                     log_msg(ERROR, "Game", "Failed to generate map");
+                    memory_pool_free(used_pool, map);
                     running = false;
-                } else {
-                    // reveal the map around the player starting position
-                    reveal_map(maps[game_state.active_map_index], 3);
-                    current = MAP_MODE;
+                    break;
                 }
+                const int floor_index = add_floor(floors, map);
+                if (floor_index < 0) {
+                    log_msg(ERROR, "Game", "Failed to add map to the floor cache");
+                    destroy_map(used_pool, map);
+                    running = false;
+                    break;
+                }
+                game_state.active_map_index = floor_index;
+                game_state.max_floors += 1;
+
+                // reveal the map around the player starting position
+                reveal_map_shadowcast(map, 3);
+                current = MAP_MODE;
                 break;
             }
             case GENERATE_ENEMY:
@@ -107,9 +157,7 @@ void start_game_loop(memory_pool_t* used_pool) {
                 game_state.player = create_empty_character(0);
 
                 // free all the previously created maps
-                for (int i = 0; i < game_state.max_floors; i++) {
-                    destroy_map(used_pool, maps[i]);
-                }
+                clear_floor_cache(floors);
                 game_state.active_map_index = -1;
                 game_state.max_floors = 0;// reset the max floor
 
@@ -126,21 +174,32 @@ void start_game_loop(memory_pool_t* used_pool) {
                     game_state.max_floors = 0;
                     game_state.active_map_index = -1;
                     game_state.player = create_empty_character(0);
-                    // maps already set to NULL, after the loading attempt
+                    // floor cache already cleared, after the loading attempt
                 }
                 break;
-            case MAP_MODE:
-                current = update_map_mode(input, maps[game_state.active_map_index], game_state.player);
+            case MAP_MODE: {
+                map_t* map = get_floor(floors, game_state.active_map_index);
+                if (map == NULL) {
+                    log_msg(ERROR, "Game", "Failed to get floor %d", game_state.active_map_index);
+                    running = false;
+                    break;
+                }
+                current = update_map_mode(input, map, game_state.player);
                 break;
+            }
             case ENTER_NEXT_FLOOR:
                 if (game_state.active_map_index + 1 == game_state.max_floors) {
                     // the player is on the newest generated floor, generate a new map
                     current = GENERATE_MAP;
                 } else if (game_state.active_map_index + 1 < game_state.max_floors) {
                     // the player is on an older floor, go to the next floor
-                    game_state.active_map_index += 1;
+                    map_t* map = change_active_floor(used_pool, &game_state, game_state.active_map_index + 1);
+                    if (map == NULL) {
+                        running = false;
+                        break;
+                    }
+                    map->player_pos = map->entry_pos;
                     current = MAP_MODE;
-                    maps[game_state.active_map_index]->player_pos = maps[game_state.active_map_index]->entry_pos;
                 } else {
                     log_msg(ERROR, "Game",
                             "Invalid map index: %d", game_state.active_map_index);
@@ -150,13 +209,22 @@ void start_game_loop(memory_pool_t* used_pool) {
             case ENTER_PREV_FLOOR:
                 if (game_state.active_map_index == 0) {
                     // revert the player position
-                    maps[game_state.active_map_index]->player_pos = maps[game_state.active_map_index]->entry_pos;
+                    map_t* map = get_floor(floors, game_state.active_map_index);
+                    if (map == NULL) {
+                        running = false;
+                        break;
+                    }
+                    map->player_pos = map->entry_pos;
                     current = MAP_MODE;
                 } else if (game_state.active_map_index > 0) {
-                    // go to the previous floor
-                    game_state.active_map_index -= 1;
+                    // go to the previous floor, it's paged back in when it was evicted
+                    map_t* map = change_active_floor(used_pool, &game_state, game_state.active_map_index - 1);
+                    if (map == NULL) {
+                        running = false;
+                        break;
+                    }
+                    map->player_pos = map->exit_pos;
                     current = MAP_MODE;
-                    maps[game_state.active_map_index]->player_pos = maps[game_state.active_map_index]->exit_pos;
                 } else {
                     log_msg(ERROR, "Game", "Invalid map index: %d",
                             game_state.active_map_index);
@@ -200,11 +268,34 @@ void start_game_loop(memory_pool_t* used_pool) {
                 running = false;
                 break;
         }
+        update_perf_hud(used_pool, monotonic_ns() - update_start);
+        end_frame();
+        record_frame_time(monotonic_ns() - tick_start);
     }
 
     destroy_character(game_state.player);
-    for (int i = 0; i < game_state.max_floors; i++) {
-        if (maps[i] != NULL) memory_pool_free(used_pool, maps[i]);
+    if (floors != NULL) destroy_floor_cache(floors);
+}
+
+map_t* change_active_floor(const memory_pool_t* pool, game_state_t* game_state, const int new_index) {
+    if (pack_map(pool, get_floor(game_state->floors, game_state->active_map_index)) != 0) {
+        // not fatal, the floor just stays unpacked
+        log_msg(WARNING, "Game", "Failed to pack floor %d", game_state->active_map_index);
+    }
+    map_t* map = get_floor(game_state->floors, new_index);
+    RETURN_WHEN_NULL(map, NULL, "Game", "Failed to get floor %d", new_index);
+    RETURN_WHEN_TRUE(unpack_map(pool, map) != 0, NULL, "Game", "Failed to unpack floor %d", new_index);
+
+    game_state->active_map_index = new_index;
+    return map;
+}
+
+void wait_for_next_tick(long long* next_tick) {
+    const long long now = monotonic_ns();
+    if (now < *next_tick) {
+        usleep((unsigned int) ((*next_tick - now) / 1000));
+        *next_tick += TICK_NS;
+    } else {
+        *next_tick = now + TICK_NS;
     }
-    memory_pool_free(used_pool, maps);
 }
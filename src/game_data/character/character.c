@@ -4,6 +4,7 @@
 #include "enemy_id.h"
 #include "../ability/ability.h"
 
+#include <stdatomic.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -101,6 +102,7 @@ Character* create_empty_character(const int id) {
                            "Character", "Failed to create inventory for character inventory")
 
     character->vtable = &character_vtable;
+    touch_character_stats(character);
 
     // add the basic abilities to the character
     const ability_t* base_ability = &get_ability_table()->abilities[character_base_ability[id].basic_ability_id];
@@ -122,6 +124,11 @@ Character* create_base_character(const int id, const char* name) {
     return character;
 }
 
+void touch_character_stats(Character* character) {
+    static atomic_uint last_stats_version = 0;
+    character->stats_version = atomic_fetch_add(&last_stats_version, 1) + 1;
+}
+
 void destroy_character(Character* character) {
     if (character == NULL) {
         log_msg(WARNING, "Character", "In `destroy_character` given character is NULL");
@@ -143,16 +150,19 @@ void destroy_character(Character* character) {
 void reset_health_c(Character* self) {
     RETURN_WHEN_NULL(self, , "Character", "In `reset_health` given character is NULL")
     self->current_resources.health = self->max_resources.health;
+    touch_character_stats(self);
 }
 
 void reset_stamina_c(Character* self) {
     RETURN_WHEN_NULL(self, , "Character", "In `reset_stamina` given character is NULL")
     self->current_resources.stamina = self->max_resources.stamina;
+    touch_character_stats(self);
 }
 
 void reset_mana_c(Character* self) {
     RETURN_WHEN_NULL(self, , "Character", "In `reset_mana` given character is NULL")
     self->current_resources.mana = self->max_resources.mana;
+    touch_character_stats(self);
 }
 
 int xp_limit_reached_c(const Character* self) {
@@ -217,6 +227,7 @@ void lvl_up_c(Character* self, const attr_id_t attr_to_increase) {
             break;
         default:;
     }
+    touch_character_stats(self);
 }
 
 int pick_up_gear_c(Character* self, const gear_t* gear) {
@@ -384,4 +395,5 @@ void apply_bonus_stats(Character* character, const resources_t* bonus_res, const
     character->current_attributes.agility += character->max_attributes.agility - prev_max_att.agility;
     character->current_attributes.constitution += character->max_attributes.constitution - prev_max_att.constitution;
     character->current_attributes.luck += character->max_attributes.luck - prev_max_att.luck;
+    touch_character_stats(character);
 }
@@ -29,6 +29,7 @@ struct Character {
     char* name;
     ArrayList* ability_list;
     Inventory* inventory;// the character's inventory
+    unsigned int stats_version;// changes with every change of the shown stats, see `touch_character_stats`
 
     const Character_VTable* vtable;
 };
@@ -137,6 +138,14 @@ Character* create_empty_character(int id);
  */
 Character* create_base_character(int id, const char* name);
 
+/**
+ * Gives the character a new stats version, which is unique over all characters. Must be called whenever
+ * the name, level, resources or attributes of the character change, so cached output is formatted again.
+ *
+ * @param character The character whose stats changed.
+ */
+void touch_character_stats(Character* character);
+
 /**
  * Destroys the character structure, freeing all its resources and memory.
  *
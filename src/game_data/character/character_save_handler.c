@@ -82,6 +82,7 @@ int read_character_data(FILE* file, Character* character) {
 
     // TODO: read the inventory data
 
+    touch_character_stats(character);
     return 0;
 }
 
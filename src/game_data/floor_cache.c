@@ -0,0 +1,292 @@
+#include "floor_cache.h"
+
+#include "../logger/logger.h"
+#include "map/map_chunks.h"
+#include "map/map_compression.h"
+#include "map/map_revealer.h"
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <direct.h>
+    #define STAT_STRUCT struct _stat
+    #define STAT_FUNC _stat
+    #define MKDIR(path) _mkdir(path)
+    #define RMDIR(path) _rmdir(path)
+    #define PATH_SEP "\\"
+#else
+    #include <unistd.h>
+    #define STAT_STRUCT struct stat
+    #define STAT_FUNC stat
+    #define MKDIR(path) mkdir(path, 0755)
+    #define RMDIR(path) rmdir(path)
+    #define PATH_SEP "/"
+#endif
+
+#define FLOOR_CACHE_DIR "floor_cache"
+#define CHUNKED_FLOOR (-1)// stored instead of the packed size, when the floor is stored in chunks
+
+static char floor_cache_dir[200] = FLOOR_CACHE_DIR;// parent of the session directories, see set_floor_cache_directory
+
+/**
+ * Creates a new, not yet existing session directory inside the floor cache directory.
+ *
+ * @param cache The cache receiving the path of the directory.
+ * @return 0 on success, 1 on failure.
+ */
+int create_session_directory(floor_cache_t* cache);
+
+/**
+ * Writes the path of the file of the given floor into the buffer.
+ */
+void get_floor_path(const floor_cache_t* cache, int floor_index, char* path, size_t size);
+
+/**
+ * Returns an empty slot, when the cache is full, the least recently used floor is written to disk and destroyed.
+ *
+ * @param cache The cache.
+ * @return The free slot, or NULL if the least recently used floor couldn't be written.
+ */
+floor_slot_t* get_free_slot(floor_cache_t* cache);
+
+/**
+ * Packs the floor and writes it to its file.
+ *
+ * @param cache The cache.
+ * @param floor_index The index of the floor.
+ * @param map The floor to write.
+ * @return 0 on success, 1 on failure.
+ */
+int write_floor(const floor_cache_t* cache, int floor_index, map_t* map);
+
+/**
+ * Reads a floor from its file, the tiles stay packed.
+ *
+ * @param cache The cache.
+ * @param floor_index The index of the floor.
+ * @return The floor, or NULL on failure.
+ */
+map_t* read_floor(const floor_cache_t* cache, int floor_index);
+
+void set_floor_cache_directory(const char* directory) {
+    RETURN_WHEN_NULL(directory, , "Floor Cache", "Floor cache directory is NULL");
+    snprintf(floor_cache_dir, sizeof(floor_cache_dir), "%s", directory);
+}
+
+floor_cache_t* create_floor_cache(const memory_pool_t* pool) {
+    RETURN_WHEN_NULL(pool, NULL, "Floor Cache", "Memory pool is NULL");
+
+    floor_cache_t* cache = memory_pool_alloc(pool, sizeof(floor_cache_t));
+    RETURN_WHEN_NULL(cache, NULL, "Floor Cache", "Failed to allocate memory for the floor cache");
+
+    cache->pool = pool;
+    cache->floor_count = 0;
+    cache->clock = 0;
+    for (int i = 0; i < FLOOR_CACHE_CAPACITY; i++) {
+        cache->slots[i].floor_index = -1;
+        cache->slots[i].last_used = 0;
+        cache->slots[i].map = NULL;
+    }
+
+    if (create_session_directory(cache) != 0) {
+        memory_pool_free(pool, cache);
+        log_msg(ERROR, "Floor Cache", "Failed to create the session directory");
+        return NULL;
+    }
+    return cache;
+}
+
+void destroy_floor_cache(floor_cache_t* cache) {
+    RETURN_WHEN_NULL(cache, , "Floor Cache", "In `destroy_floor_cache` cache is NULL");
+
+    clear_floor_cache(cache);
+    RMDIR(cache->directory);
+    memory_pool_free(cache->pool, cache);
+}
+
+void clear_floor_cache(floor_cache_t* cache) {
+    RETURN_WHEN_NULL(cache, , "Floor Cache", "In `clear_floor_cache` cache is NULL");
+
+    for (int i = 0; i < FLOOR_CACHE_CAPACITY; i++) {
+        if (cache->slots[i].map != NULL) destroy_map(cache->pool, cache->slots[i].map);
+        cache->slots[i].floor_index = -1;
+        cache->slots[i].map = NULL;
+    }
+    // not every floor has a file, so failing removals are expected
+    for (int i = 0; i < cache->floor_count; i++) {
+        char path[512];
+        get_floor_path(cache, i, path, sizeof(path));
+        remove(path);
+    }
+    cache->floor_count = 0;
+    cache->clock = 0;
+}
+
+int add_floor(floor_cache_t* cache, map_t* map) {
+    RETURN_WHEN_NULL(cache, -1, "Floor Cache", "In `add_floor` cache is NULL");
+    RETURN_WHEN_NULL(map, -1, "Floor Cache", "In `add_floor` map is NULL");
+    RETURN_WHEN_TRUE(map->batch_owned, -1, "Floor Cache", "Floor %d belongs to a map batch and can't be cached",
+                     map->floor_nr);
+
+    floor_slot_t* slot = get_free_slot(cache);
+    RETURN_WHEN_NULL(slot, -1, "Floor Cache", "No free slot for floor %d", cache->floor_count);
+
+    slot->floor_index = cache->floor_count++;
+    slot->last_used = ++cache->clock;
+    slot->map = map;
+    return slot->floor_index;
+}
+
+map_t* get_floor(floor_cache_t* cache, const int floor_index) {
+    RETURN_WHEN_NULL(cache, NULL, "Floor Cache", "In `get_floor` cache is NULL");
+    RETURN_WHEN_TRUE(floor_index < 0 || floor_index >= cache->floor_count, NULL,
+                     "Floor Cache", "Invalid floor index %d", floor_index);
+
+    for (int i = 0; i < FLOOR_CACHE_CAPACITY; i++) {
+        if (cache->slots[i].floor_index == floor_index) {
+            cache->slots[i].last_used = ++cache->clock;
+            return cache->slots[i].map;
+        }
+    }
+
+    // page the floor back in
+    floor_slot_t* slot = get_free_slot(cache);
+    RETURN_WHEN_NULL(slot, NULL, "Floor Cache", "No free slot for floor %d", floor_index);
+    map_t* map = read_floor(cache, floor_index);
+    RETURN_WHEN_NULL(map, NULL, "Floor Cache", "Failed to read floor %d", floor_index);
+
+    slot->floor_index = floor_index;
+    slot->last_used = ++cache->clock;
+    slot->map = map;
+    return map;
+}
+
+map_t* peek_floor(const floor_cache_t* cache, const int floor_index, int* is_copy) {
+    RETURN_WHEN_NULL(cache, NULL, "Floor Cache", "In `peek_floor` cache is NULL");
+    RETURN_WHEN_NULL(is_copy, NULL, "Floor Cache", "In `peek_floor` is_copy is NULL");
+    RETURN_WHEN_TRUE(floor_index < 0 || floor_index >= cache->floor_count, NULL,
+                     "Floor Cache", "Invalid floor index %d", floor_index);
+
+    for (int i = 0; i < FLOOR_CACHE_CAPACITY; i++) {
+        if (cache->slots[i].floor_index == floor_index) {
+            *is_copy = 0;
+            return cache->slots[i].map;
+        }
+    }
+    *is_copy = 1;
+    return read_floor(cache, floor_index);
+}
+
+void release_floor(const floor_cache_t* cache, map_t* map, const int is_copy) {
+    if (cache == NULL || map == NULL || !is_copy) return;
+    destroy_map(cache->pool, map);
+}
+
+int create_session_directory(floor_cache_t* cache) {
+    STAT_STRUCT st;
+    if (STAT_FUNC(floor_cache_dir, &st) != 0 && MKDIR(floor_cache_dir) != 0) return 1;
+
+    // several games may run at the same time, so the first unused name is taken
+    const long session = (long) time(NULL);
+    for (int i = 0; i < 100; i++) {
+        snprintf(cache->directory, sizeof(cache->directory), "%s%ssession_%ld_%d", floor_cache_dir, PATH_SEP,
+                 session, i);
+        if (STAT_FUNC(cache->directory, &st) != 0 && MKDIR(cache->directory) == 0) return 0;
+    }
+    return 1;
+}
+
+void get_floor_path(const floor_cache_t* cache, const int floor_index, char* path, const size_t size) {
+    snprintf(path, size, "%s%sfloor_%d.bin", cache->directory, PATH_SEP, floor_index);
+}
+
+floor_slot_t* get_free_slot(floor_cache_t* cache) {
+    floor_slot_t* oldest = &cache->slots[0];
+    for (int i = 0; i < FLOOR_CACHE_CAPACITY; i++) {
+        if (cache->slots[i].map == NULL) return &cache->slots[i];
+        if (cache->slots[i].last_used < oldest->last_used) oldest = &cache->slots[i];
+    }
+
+    RETURN_WHEN_TRUE(write_floor(cache, oldest->floor_index, oldest->map) != 0, NULL,
+                     "Floor Cache", "Failed to evict floor %d", oldest->floor_index);
+    destroy_map(cache->pool, oldest->map);
+    oldest->floor_index = -1;
+    oldest->map = NULL;
+    return oldest;
+}
+
+int write_floor(const floor_cache_t* cache, const int floor_index, map_t* map) {
+    RETURN_WHEN_TRUE(pack_map(cache->pool, map) != 0, 1, "Floor Cache", "Failed to pack floor %d", floor_index);
+
+    char path[512];
+    get_floor_path(cache, floor_index, path, sizeof(path));
+    FILE* file = fopen(path, "wb");
+    RETURN_WHEN_NULL(file, 1, "Floor Cache", "Failed to open %s for writing", path);
+
+    // floor_nr, width, height, enemy_count, exit_unlocked, entry_pos, exit_pos and player_pos
+    int ok = fwrite(&map->floor_nr, sizeof(int), 11, file) == 11;
+    if (map->chunks != NULL) {
+        const int marker = CHUNKED_FLOOR;
+        ok = ok && fwrite(&marker, sizeof(int), 1, file) == 1;
+        ok = ok && write_map_chunks(file, map->chunks) == 0;
+    } else {
+        const size_t mask_words = MASK_WORDS(map->width * map->height);
+        ok = ok && fwrite(&map->packed_size, sizeof(int), 1, file) == 1;
+        ok = ok && fwrite(map->packed_tiles, 1, map->packed_size, file) == (size_t) map->packed_size;
+        ok = ok && fwrite(map->revealed_mask, sizeof(uint64_t), mask_words, file) == mask_words;
+    }
+    ok = fclose(file) == 0 && ok;
+
+    RETURN_WHEN_TRUE(!ok, 1, "Floor Cache", "Failed to write floor %d", floor_index);
+    return 0;
+}
+
+map_t* read_floor(const floor_cache_t* cache, const int floor_index) {
+    char path[512];
+    get_floor_path(cache, floor_index, path, sizeof(path));
+    FILE* file = fopen(path, "rb");
+    RETURN_WHEN_NULL(file, NULL, "Floor Cache", "Failed to open %s for reading", path);
+
+    map_t* map = memory_pool_alloc(cache->pool, sizeof(map_t));
+    RETURN_WHEN_NULL_CLEAN(map, NULL, fclose(file), "Floor Cache", "Failed to allocate memory for floor %d",
+                           floor_index);
+    map->hidden_tiles = NULL;
+    map->revealed_mask = NULL;
+    map->chunks = NULL;
+    map->packed_tiles = NULL;
+    map->packed_size = 0;
+    map->batch_owned = 0;
+    forget_lit_origins(map);
+    reset_reveal_events(map);
+    touch_map_tiles(map);
+
+    int size = 0;
+    int ok = fread(&map->floor_nr, sizeof(int), 11, file) == 11 && fread(&size, sizeof(int), 1, file) == 1;
+    if (ok && size == CHUNKED_FLOOR) {
+        map->chunks = create_map_chunks(cache->pool, map->width, map->height);
+        ok = map->chunks != NULL && read_map_chunks(file, map->chunks) == 0;
+    } else if (ok && size > 0) {
+        const size_t mask_words = MASK_WORDS(map->width * map->height);
+        map->packed_tiles = memory_pool_alloc(cache->pool, size);
+        map->packed_size = size;
+        map->revealed_mask = memory_pool_alloc(cache->pool, mask_words * sizeof(uint64_t));
+        ok = map->packed_tiles != NULL && map->revealed_mask != NULL &&
+             fread(map->packed_tiles, 1, size, file) == (size_t) size &&
+             fread(map->revealed_mask, sizeof(uint64_t), mask_words, file) == mask_words;
+    } else {
+        ok = 0;
+    }
+    fclose(file);
+
+    if (!ok) {
+        if (map->chunks != NULL) destroy_map_chunks(map->chunks);
+        if (map->packed_tiles != NULL) memory_pool_free(cache->pool, map->packed_tiles);
+        if (map->revealed_mask != NULL) memory_pool_free(cache->pool, map->revealed_mask);
+        memory_pool_free(cache->pool, map);
+        log_msg(ERROR, "Floor Cache", "Failed to read floor %d", floor_index);
+        return NULL;
+    }
+    return map;
+}
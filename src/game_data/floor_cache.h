@@ -0,0 +1,100 @@
+#ifndef FLOOR_CACHE_H
+#define FLOOR_CACHE_H
+
+#include "../memory/mem_mgmt.h"
+#include "map/map.h"
+
+#define FLOOR_CACHE_CAPACITY 4// number of floors kept in memory
+
+typedef struct {
+    int floor_index;        // index of the cached floor, -1 if the slot is empty
+    unsigned long last_used;// value of the cache clock when the floor was accessed the last time
+    map_t* map;
+} floor_slot_t;
+
+/**
+ * Keeps the most recently used floors in memory, all other floors are evicted to a per session directory
+ * on disk and paged back in when they are accessed again. The memory use is independent of the number
+ * of floors. Floors are identified by their index, starting at 0.
+ */
+typedef struct floor_cache {
+    const memory_pool_t* pool;
+    int floor_count;    // number of floors added so far, the indices are 0 to floor_count - 1
+    unsigned long clock;// increased with every access
+    char directory[256];// the session directory of the evicted floors
+    floor_slot_t slots[FLOOR_CACHE_CAPACITY];
+} floor_cache_t;
+
+/**
+ * Sets the directory the session directories of the floor caches are created in, it is created when missing.
+ * Only affects caches created afterward. Defaults to "floor_cache" relative to the working directory, paths longer
+ * than 199 characters are truncated.
+ *
+ * @param directory The path of the floor cache directory.
+ */
+void set_floor_cache_directory(const char* directory);
+
+/**
+ * Creates an empty floor cache and its session directory.
+ *
+ * @param pool The memory pool the floors are allocated from.
+ * @return The floor cache, or NULL on failure.
+ */
+floor_cache_t* create_floor_cache(const memory_pool_t* pool);
+
+/**
+ * Destroys all cached floors, deletes the evicted floors and the session directory and frees the cache.
+ *
+ * @param cache The cache to destroy.
+ */
+void destroy_floor_cache(floor_cache_t* cache);
+
+/**
+ * Destroys all cached floors and deletes all evicted floors, the cache is empty afterward.
+ *
+ * @param cache The cache to clear.
+ */
+void clear_floor_cache(floor_cache_t* cache);
+
+/**
+ * Adds a new floor with the next index to the cache, which takes over the ownership of the map.
+ * When the cache is full, the least recently used floor is evicted.
+ *
+ * @param cache The cache.
+ * @param map The map of the floor, allocated from the pool of the cache. Maps of a map batch are rejected.
+ * @return The index of the new floor, or -1 if the map belongs to a batch or the least recently used floor
+ *         couldn't be evicted.
+ */
+int add_floor(floor_cache_t* cache, map_t* map);
+
+/**
+ * Returns the floor with the given index, evicted floors are read back from disk. Floors read from disk
+ * are returned packed (see map_compression.h). When the cache is full, the least recently used floor is evicted.
+ *
+ * @param cache The cache.
+ * @param floor_index The index of the floor.
+ * @return The floor, or NULL if the index is invalid or the floor couldn't be read.
+ */
+map_t* get_floor(floor_cache_t* cache, int floor_index);
+
+/**
+ * Returns the floor with the given index, without changing the content of the cache.
+ * Evicted floors are read as a copy, which must be destroyed by the caller when `is_copy` is set.
+ *
+ * @param cache The cache.
+ * @param floor_index The index of the floor.
+ * @param is_copy Set to 1 if the returned floor is a copy read from disk, 0 otherwise.
+ * @return The floor, or NULL if the index is invalid or the floor couldn't be read.
+ */
+map_t* peek_floor(const floor_cache_t* cache, int floor_index, int* is_copy);
+
+/**
+ * Releases a floor returned by `peek_floor`, copies are destroyed, cached floors stay untouched.
+ *
+ * @param cache The cache.
+ * @param map The floor returned by `peek_floor`.
+ * @param is_copy The copy flag returned by `peek_floor`.
+ */
+void release_floor(const floor_cache_t* cache, map_t* map, int is_copy);
+
+#endif//FLOOR_CACHE_H
@@ -1,23 +1,132 @@
 #include "map.h"
 
 #include "../../logger/logger.h"
+#include "map_chunks.h"
+
+#include <stdatomic.h>
 
 void destroy_map(const memory_pool_t* pool, map_t* map_to_destroy) {
     RETURN_WHEN_NULL(pool, , "Map", "Memory pool is NULL")
     RETURN_WHEN_NULL(map_to_destroy, , "Map", "Map to destroy is NULL")
+    RETURN_WHEN_TRUE(map_to_destroy->batch_owned, , "Map",
+                     "Map %d belongs to a map batch, which must be destroyed instead", map_to_destroy->floor_nr)
 
-    if (map_to_destroy->hidden_tiles != NULL) {
+    if (map_to_destroy->chunks != NULL) {
+        destroy_map_chunks(map_to_destroy->chunks);
+        map_to_destroy->chunks = NULL;
+        memory_pool_free(pool, map_to_destroy);
+        return;
+    }
+    if (map_to_destroy->packed_tiles != NULL) {
+        memory_pool_free(pool, map_to_destroy->packed_tiles);
+        map_to_destroy->packed_tiles = NULL;
+    } else if (map_to_destroy->hidden_tiles != NULL) {
         memory_pool_free(pool, map_to_destroy->hidden_tiles);
         map_to_destroy->hidden_tiles = NULL;
     } else {
         log_msg(WARNING, "Map", "In `destroy_map` map to destroy has no hidden tiles");
     }
-    if (map_to_destroy->revealed_tiles != NULL) {
-        memory_pool_free(pool, map_to_destroy->revealed_tiles);
-        map_to_destroy->revealed_tiles = NULL;
+    if (map_to_destroy->revealed_mask != NULL) {
+        memory_pool_free(pool, map_to_destroy->revealed_mask);
+        map_to_destroy->revealed_mask = NULL;
     } else {
-        log_msg(WARNING, "Map", "In `destroy_map` map to destroy has no revealed tiles");
+        log_msg(WARNING, "Map", "In `destroy_map` map to destroy has no revealed mask");
     }
 
     memory_pool_free(pool, map_to_destroy);
 }
+
+map_tile_t get_hidden_tile(const map_t* map, const int x, const int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) return WALL;
+    if (map->chunks != NULL) return get_chunked_hidden_tile(map, x, y);
+    return map->hidden_tiles[x * map->height + y];
+}
+
+map_tile_t get_revealed_tile(const map_t* map, const int x, const int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) return HIDDEN;
+    if (map->chunks != NULL) return get_chunked_revealed_tile(map, x, y);
+    const int index = x * map->height + y;
+    return IS_REVEALED(map->revealed_mask, index) ? map->hidden_tiles[index] : HIDDEN;
+}
+
+void set_hidden_tile(map_t* map, const int x, const int y, const map_tile_t tile) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) return;
+    touch_map_tiles(map);
+    if (map->chunks != NULL) {
+        set_chunked_hidden_tile(map, x, y, tile);
+    } else {
+        map->hidden_tiles[x * map->height + y] = tile;
+    }
+}
+
+void touch_map_tiles(map_t* map) {
+    static atomic_uint last_tiles_version = 0;
+    map->tiles_version = atomic_fetch_add(&last_tiles_version, 1) + 1;
+}
+
+void reveal_tile(const map_t* map, const int x, const int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) return;
+    if (map->chunks != NULL) {
+        set_chunked_revealed(map, x, y, 1);
+    } else {
+        SET_REVEALED(map->revealed_mask, x * map->height + y);
+    }
+}
+
+void hide_tile(const map_t* map, const int x, const int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) return;
+    if (map->chunks != NULL) {
+        set_chunked_revealed(map, x, y, 0);
+    } else {
+        CLEAR_REVEALED(map->revealed_mask, x * map->height + y);
+    }
+}
+
+void record_reveal_event(map_t* map, const int x, const int y, const int width, const int height) {
+    RETURN_WHEN_NULL(map, , "Map", "In `record_reveal_event` map is NULL")
+    map->reveal_events[map->reveal_event_count & (REVEAL_EVENT_SLOTS - 1)] = (reveal_event_t) {x, y, width, height};
+    map->reveal_event_count++;
+}
+
+void reset_reveal_events(map_t* map) {
+    static atomic_uint last_reveal_version = 0;
+    RETURN_WHEN_NULL(map, , "Map", "In `reset_reveal_events` map is NULL")
+    map->reveal_version = atomic_fetch_add(&last_reveal_version, 1) + 1;
+    map->reveal_event_count = 0;
+}
+
+int count_revealed_tiles(const map_t* map) {
+    RETURN_WHEN_NULL(map, 0, "Map", "In `count_revealed_tiles` map is NULL")
+    if (map->chunks != NULL) return count_chunked_revealed(map->chunks);
+
+    int count = 0;
+    for (int i = 0; i < MASK_WORDS(map->width * map->height); i++) {
+        count += __builtin_popcountll(map->revealed_mask[i]);
+    }
+    return count;
+}
+
+void expand_revealed_tiles(const map_tile_t* hidden_tiles, const uint64_t* revealed_mask, const int start,
+                           const int count, map_tile_t* revealed_tiles) {
+    for (int i = 0; i < count; i++) {
+        revealed_tiles[i] = IS_REVEALED(revealed_mask, start + i) ? hidden_tiles[start + i] : HIDDEN;
+    }
+}
+
+void merge_revealed_tiles(const map_tile_t* revealed_tiles, const int start, const int count, uint64_t* revealed_mask) {
+    for (int i = 0; i < count; i++) {
+        if (revealed_tiles[i] != HIDDEN) SET_REVEALED(revealed_mask, start + i);
+    }
+}
+
+int get_neighbour_indices(const map_t* map, const int index, int neighbours[4]) {
+    const int height = map->height;
+    const int x = index / height;
+    const int y = index % height;
+    int count = 0;
+    if (y > 0) neighbours[count++] = index - 1;
+    if (y < height - 1) neighbours[count++] = index + 1;
+    if (x > 0) neighbours[count++] = index - height;
+    if (x < map->width - 1) neighbours[count++] = index + height;
+    return count;
+}
@@ -1,9 +1,10 @@
 #ifndef MAP_H
 #define MAP_H
 
-#include "../../io/colors.h"
 #include "../../memory/mem_mgmt.h"
 
+#include <stdint.h>
+
 typedef enum {
     WALL,
     FLOOR,
@@ -24,6 +25,23 @@ typedef struct vector2d {
     int dy;
 } vector2d_t;
 
+typedef struct map_chunks map_chunks_t;// see map_chunks.h
+
+#define LIT_ORIGIN_SLOTS 64// must be a power of two
+#define REVEAL_EVENT_SLOTS 16// must be a power of two
+
+#define MASK_WORDS(count) (((count) + 63) / 64)// number of 64-bit words of a mask with one bit per tile
+#define IS_REVEALED(mask, i) (((mask)[(i) >> 6] >> ((i) & 63)) & 1)
+#define SET_REVEALED(mask, i) ((mask)[(i) >> 6] |= (uint64_t) 1 << ((i) & 63))
+#define CLEAR_REVEALED(mask, i) ((mask)[(i) >> 6] &= ~((uint64_t) 1 << ((i) & 63)))
+
+typedef struct {
+    int x;// top left tile of an area in which tiles were revealed
+    int y;
+    int width;
+    int height;
+} reveal_event_t;
+
 typedef struct map {
     int floor_nr;// the floor-number this map represents
     int width;
@@ -33,8 +51,18 @@ typedef struct map {
     vector2d_t entry_pos;// the entry position
     vector2d_t exit_pos; // the exit position
     vector2d_t player_pos;
-    map_tile_t* hidden_tiles;  //the total size being height * width
-    map_tile_t* revealed_tiles;//the total size being height * width
+    map_tile_t* hidden_tiles;   //the total size being height * width
+    uint64_t* revealed_mask;    //one bit per tile with the same index as the hidden tiles, set if revealed
+    map_chunks_t* chunks;       //when not NULL, the tiles are stored in lazily generated chunks instead
+    unsigned char* packed_tiles;//when not NULL, the floor is inactive and its tiles are run-length encoded here
+    int packed_size;            //size of packed_tiles in bytes
+    int batch_owned;            //non-zero if the map and its tiles live inside a map batch, see map_batch.h
+    unsigned int tiles_version; //changes with every change of the hidden tiles, unique over all maps
+    int lit_radius;             //light radius of the lit origins
+    vector2d_t lit_origins[LIT_ORIGIN_SLOTS];//recent positions the map was revealed from, see reveal_map_step
+    unsigned int reveal_version;    //changes whenever the revealed tiles are reset or replaced, unique over all maps
+    unsigned int reveal_event_count;//number of reveal events since the last reset, see record_reveal_event
+    reveal_event_t reveal_events[REVEAL_EVENT_SLOTS];//the latest reveal events, index count & (REVEAL_EVENT_SLOTS - 1)
 } map_t;
 
 static const vector2d_t directions[4] = {
@@ -44,24 +72,122 @@ static const vector2d_t directions[4] = {
         {1, 0}  // right
 };
 
-static struct {
-    map_tile_t tile;
-    char symbol;
-    color_t foreground_color;
-    color_t background_color;
-} tiles_mapping[] = {
-        {WALL, '#', BLUE, BLUE},
-        {FLOOR, ' ', WHITE, BLACK},
-        {START_DOOR, '#', GREEN, BLACK},
-        {EXIT_DOOR, '#', YELLOW, BLACK},
-        {DOOR_KEY, '$', YELLOW, BLACK},
-        {LIFE_FOUNTAIN, '+', RED, BLACK},
-        {MANA_FOUNTAIN, '+', BLUE, BLACK},
-        {STAMINA_FOUNTAIN, '+', GREEN, BLACK},
-        {PLAYER, '@', RED, BLACK},
-        {ENEMY, '!', WHITE, RED},
-        {HIDDEN, ' ', WHITE, WHITE}};
-
+/**
+ * Frees the map and its tiles. Maps of a map batch are only freed with their batch, they are left unchanged.
+ *
+ * @param pool The memory pool the map was allocated from.
+ * @param map_to_destroy The map to destroy.
+ */
 void destroy_map(const memory_pool_t* pool, map_t* map_to_destroy);
 
+/**
+ * Returns the hidden tile at the given position. Works for contiguous and chunked maps,
+ * on chunked maps the containing chunk is generated if needed.
+ *
+ * @param map The map to read from.
+ * @param x The x-coordinate of the tile.
+ * @param y The y-coordinate of the tile.
+ * @return The tile at the position, or WALL if the position is out of bounds.
+ */
+map_tile_t get_hidden_tile(const map_t* map, int x, int y);
+
+/**
+ * Returns the revealed tile at the given position, which is the hidden tile read through the revealed mask.
+ * Works for contiguous and chunked maps, on chunked maps no chunk is generated, not generated chunks are HIDDEN.
+ *
+ * @param map The map to read from.
+ * @param x The x-coordinate of the tile.
+ * @param y The y-coordinate of the tile.
+ * @return The tile at the position, or HIDDEN if the position is out of bounds.
+ */
+map_tile_t get_revealed_tile(const map_t* map, int x, int y);
+
+/**
+ * Sets the hidden tile at the given position, out of bounds positions are ignored.
+ * The tiles version of the map changes, see `touch_map_tiles`.
+ */
+void set_hidden_tile(map_t* map, int x, int y, map_tile_t tile);
+
+/**
+ * Gives the map a new tiles version, which is unique over all maps. Must be called whenever the hidden
+ * tiles are written without `set_hidden_tile`, so data derived from the tiles (e.g. flow fields) is updated.
+ *
+ * @param map The map whose hidden tiles changed.
+ */
+void touch_map_tiles(map_t* map);
+
+/**
+ * Marks the tile at the given position as revealed, out of bounds positions are ignored.
+ */
+void reveal_tile(const map_t* map, int x, int y);
+
+/**
+ * Marks the tile at the given position as hidden again, out of bounds positions are ignored.
+ */
+void hide_tile(const map_t* map, int x, int y);
+
+/**
+ * Records that tiles inside the given area were revealed, so data derived from the revealed tiles
+ * (e.g. the minimap) only has to update that area. Only the latest REVEAL_EVENT_SLOTS events are kept,
+ * a consumer that missed more events must rebuild its data from the revealed tiles.
+ *
+ * @param map The map whose tiles were revealed.
+ * @param x The x-coordinate of the top left tile of the area.
+ * @param y The y-coordinate of the top left tile of the area.
+ * @param width The width of the area.
+ * @param height The height of the area.
+ */
+void record_reveal_event(map_t* map, int x, int y, int width, int height);
+
+/**
+ * Drops the recorded reveal events and gives the map a new reveal version, which is unique over all maps.
+ * Must be called whenever the revealed tiles of a map are reset or replaced, e.g. after loading the map.
+ *
+ * @param map The map whose revealed tiles were reset or replaced.
+ */
+void reset_reveal_events(map_t* map);
+
+/**
+ * Counts the revealed tiles of a map with a popcount over its revealed mask. On chunked maps, only
+ * the generated chunks are counted.
+ *
+ * @param map The map, which may be packed or chunked.
+ * @return The number of revealed tiles.
+ */
+int count_revealed_tiles(const map_t* map);
+
+/**
+ * Reads a range of hidden tiles through the revealed mask, tiles without their bit set become HIDDEN.
+ *
+ * @param hidden_tiles The hidden tiles.
+ * @param revealed_mask The revealed mask of the hidden tiles.
+ * @param start The index of the first tile.
+ * @param count The number of tiles.
+ * @param revealed_tiles Receives `count` revealed tiles.
+ */
+void expand_revealed_tiles(const map_tile_t* hidden_tiles, const uint64_t* revealed_mask, int start, int count,
+                           map_tile_t* revealed_tiles);
+
+/**
+ * Sets the bits of all tiles in a range of revealed tiles which are not HIDDEN, the other bits are unchanged.
+ *
+ * @param revealed_tiles The revealed tiles.
+ * @param start The index of the first tile.
+ * @param count The number of tiles.
+ * @param revealed_mask The mask to merge the tiles into.
+ */
+void merge_revealed_tiles(const map_tile_t* revealed_tiles, int start, int count, uint64_t* revealed_mask);
+
+/**
+ * Collects the indices of the orthogonal neighbours of a tile which lie inside the map, in the order of `directions`.
+ * The bounds are checked per axis, since doors lie on the outer border and index - 1 of a tile in the top row would
+ * wrap around into the bottom row of the previous column.
+ *
+ * @param map The map, only its size is used.
+ * @param index The index of the tile.
+ * @param neighbours Receives up to 4 neighbour indices.
+ * @return The number of neighbours written.
+ */
+int get_neighbour_indices(const map_t* map, int index, int neighbours[4]);
+
 #endif//MAP_H
@@ -0,0 +1,129 @@
+#include "map_batch.h"
+
+#include "../../logger/logger.h"
+#include "../../thread/thread_handler.h"
+#include "map_chunks.h"
+#include "map_generator.h"
+#include "map_random.h"
+#include "map_revealer.h"
+
+#include <stdint.h>
+
+#define ALIGN_UP(size) (((size) + MAP_BATCH_ALIGNMENT - 1) / MAP_BATCH_ALIGNMENT * MAP_BATCH_ALIGNMENT)
+
+#define MAX_BATCH_THREADS 64
+
+typedef struct {
+    map_batch_t* batch;
+    const unsigned int* seeds;
+    int first;// first floor index generated by the worker
+    int last; // last floor index (exclusive)
+    int generate_last_exit;
+    int result;// 0 if all floors of the worker were generated
+} batch_worker_t;
+
+/**
+ * Generates the floors [first, last) of the worker, each floor with its own seed.
+ *
+ * @param arg A pointer to the `batch_worker_t` of this worker.
+ */
+void generate_batch_floors(void* arg);
+
+map_batch_t* generate_map_batch(const memory_pool_t* pool, const map_t* map_template, const int count,
+                                const int generate_last_exit, int thread_count) {
+    RETURN_WHEN_NULL(pool, NULL, "Map Batch", "Memory pool is NULL")
+    RETURN_WHEN_NULL(map_template, NULL, "Map Batch", "Map template is NULL")
+    RETURN_WHEN_TRUE(count <= 0, NULL, "Map Batch", "Floor count must be greater than 0, was %d", count)
+
+    map_t dimensions = *map_template;
+    normalize_map_dimensions(&dimensions);
+    RETURN_WHEN_TRUE(map_uses_chunks(dimensions.width, dimensions.height), NULL, "Map Batch",
+                     "Map dimensions %dx%d require chunks, which can't be batched", dimensions.width, dimensions.height)
+
+    const size_t header_size = ALIGN_UP(sizeof(map_batch_t));
+    const size_t maps_size = ALIGN_UP(count * sizeof(map_t));
+    const size_t tiles_size = ALIGN_UP((size_t) dimensions.width * dimensions.height * sizeof(map_tile_t));
+    const size_t mask_size = ALIGN_UP(MASK_WORDS((size_t) dimensions.width * dimensions.height) * sizeof(uint64_t));
+    // the pool only aligns to the block header, so reserve enough to align the start ourselves
+    const size_t total_size = MAP_BATCH_ALIGNMENT + header_size + maps_size + count * (tiles_size + mask_size);
+
+    void* memory = memory_pool_alloc(pool, total_size);
+    RETURN_WHEN_NULL(memory, NULL, "Map Batch", "Failed to allocate %zu bytes for %d floors", total_size, count)
+
+    char* base = (char*) ALIGN_UP((uintptr_t) memory);
+    map_batch_t* batch = (map_batch_t*) base;
+    batch->count = count;
+    batch->maps = (map_t*) (base + header_size);
+    batch->memory = memory;
+
+    char* tiles = base + header_size + maps_size;
+    for (int i = 0; i < count; i++) {
+        map_t* map = &batch->maps[i];
+        map->floor_nr = map_template->floor_nr + i;
+        map->width = dimensions.width;
+        map->height = dimensions.height;
+        map->enemy_count = map_template->enemy_count;
+        map->chunks = NULL;
+        map->packed_tiles = NULL;
+        map->packed_size = 0;
+        map->batch_owned = 1;
+        forget_lit_origins(map);
+        reset_reveal_events(map);
+        map->hidden_tiles = (map_tile_t*) (tiles + i * (tiles_size + mask_size));
+        map->revealed_mask = (uint64_t*) (tiles + i * (tiles_size + mask_size) + tiles_size);
+    }
+
+    // every floor gets its own seed, independent of the worker that generates it
+    unsigned int seeds[count];
+    for (int i = 0; i < count; i++) {
+        seeds[i] = (unsigned int) map_rand();
+    }
+
+    if (thread_count > count) thread_count = count;
+    if (thread_count > MAX_BATCH_THREADS) thread_count = MAX_BATCH_THREADS;
+    if (thread_count < 1) thread_count = 1;
+
+    batch_worker_t workers[thread_count];
+    thread_t threads[thread_count];
+    int started[thread_count];
+    for (int i = 0; i < thread_count; i++) {
+        workers[i] = (batch_worker_t) {batch, seeds, count * i / thread_count, count * (i + 1) / thread_count,
+                                       generate_last_exit, 0};
+        // the first range is always generated on the calling thread
+        started[i] = i > 0 && start_joinable_thread(&threads[i], generate_batch_floors, &workers[i]) == 0;
+    }
+    for (int i = 0; i < thread_count; i++) {
+        if (!started[i]) generate_batch_floors(&workers[i]);
+    }
+
+    int result = 0;
+    for (int i = 0; i < thread_count; i++) {
+        if (started[i]) join_thread(threads[i]);
+        result |= workers[i].result;
+    }
+
+    RETURN_WHEN_TRUE_CLEAN(result != 0, NULL, memory_pool_free(pool, memory),
+                           "Map Batch", "Failed to generate the floors of the batch")
+    return batch;
+}
+
+void destroy_map_batch(const memory_pool_t* pool, map_batch_t* batch) {
+    RETURN_WHEN_NULL(pool, , "Map Batch", "Memory pool is NULL")
+    RETURN_WHEN_NULL(batch, , "Map Batch", "Batch to destroy is NULL")
+
+    memory_pool_free(pool, batch->memory);
+}
+
+void generate_batch_floors(void* arg) {
+    batch_worker_t* worker = (batch_worker_t*) arg;
+
+    for (int i = worker->first; i < worker->last; i++) {
+        seed_map_rand(worker->seeds[i]);
+
+        const int generate_exit = i != worker->batch->count - 1 || worker->generate_last_exit;
+        if (generate_map_tiles(&worker->batch->maps[i], generate_exit) != 0) {
+            log_msg(ERROR, "Map Batch", "Failed to generate floor %d", worker->batch->maps[i].floor_nr);
+            worker->result = 1;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef MAP_BATCH_H
+#define MAP_BATCH_H
+
+#include "../../memory/mem_mgmt.h"
+#include "map.h"
+
+#define MAP_BATCH_ALIGNMENT 64// the map structs and each tile array start on a cache line
+
+typedef struct {
+    int count;   // number of floors in the batch
+    map_t* maps; // the floors, floor i is maps[i]
+    void* memory;// the single pool allocation holding this struct, the maps and all tiles
+} map_batch_t;
+
+/**
+ * Generates several floors in one call into a single contiguous, aligned allocation.
+ * The batch header, all map structs and the tiles of each floor (the hidden tiles followed by the revealed
+ * bit mask) are laid out one after another. Each floor gets its own seed up front, so the result only depends
+ * on the random state of the calling thread and not on the number of worker threads.
+ *
+ * @param pool The memory pool used for the single allocation.
+ * @param map_template The width, height, enemy_count and floor_nr (of the first floor) of the floors.
+ *                     The dimensions must not require a chunked map.
+ * @param count The number of floors to generate.
+ * @param generate_last_exit Non-zero if the last floor gets an exit, all other floors always get one.
+ * @param thread_count The number of worker threads, values below 2 generate on the calling thread.
+ * @return A pointer to the batch, or NULL if the allocation or the generation of a floor failed.
+ * @note The floors are owned by the batch and marked with `batch_owned`. They must be freed with `destroy_map_batch`,
+ *       `destroy_map` and `pack_map` refuse them, so they can't be added to a floor cache either.
+ */
+map_batch_t* generate_map_batch(const memory_pool_t* pool, const map_t* map_template, int count,
+                                int generate_last_exit, int thread_count);
+
+/**
+ * Frees the single allocation of the batch, including all of its floors.
+ *
+ * @param pool The memory pool the batch was allocated from.
+ * @param batch The batch to destroy.
+ */
+void destroy_map_batch(const memory_pool_t* pool, map_batch_t* batch);
+
+#endif//MAP_BATCH_H
@@ -0,0 +1,236 @@
+#include "map_bitboard.h"
+
+typedef struct {
+    uint64_t up;   // bit y is set if (x, y - 1) is set
+    uint64_t down; // bit y is set if (x, y + 1) is set
+    uint64_t left; // bit y is set if (x - 1, y) is set
+    uint64_t right;// bit y is set if (x + 1, y) is set
+} neighbour_words_t;
+
+/**
+ * Collects the 4-neighbours of all tiles in one word of a column.
+ *
+ * @param board The bitboard.
+ * @param x The column.
+ * @param w The word inside the column.
+ * @return The neighbour words, tiles outside the board are treated as not set.
+ */
+neighbour_words_t get_neighbour_words(const bitboard_t* board, int x, int w);
+
+/**
+ * @return The word `w` of column `x` with bit y holding the tile (x, y - 1), 0 outside the board.
+ */
+uint64_t get_up_word(const bitboard_t* board, int x, int w);
+
+/**
+ * @return The word `w` of column `x` with bit y holding the tile (x, y + 1), 0 outside the board.
+ */
+uint64_t get_down_word(const bitboard_t* board, int x, int w);
+
+/**
+ * @return The mask of the bits inside the board for the given word of a column.
+ */
+uint64_t valid_word_mask(const bitboard_t* board, int w);
+
+void init_bitboard(bitboard_t* board, uint64_t* bits, const int width, const int height) {
+    board->width = width;
+    board->height = height;
+    board->words = BITBOARD_WORDS(height);
+    board->bits = bits;
+
+    for (int i = 0; i < BITBOARD_SIZE(width, height); i++) {
+        bits[i] = 0;
+    }
+}
+
+void fill_open_bitboard(const bitboard_t* board, const map_tile_t* tiles) {
+    for (int x = 0; x < board->width; x++) {
+        const map_tile_t* column = tiles + x * board->height;
+        uint64_t* words = board->bits + x * board->words;
+
+        for (int w = 0; w < board->words; w++) {
+            uint64_t word = 0;
+            const int end = (w + 1) * 64 < board->height ? 64 : board->height - w * 64;
+            for (int b = 0; b < end; b++) {
+                word |= (uint64_t) (column[w * 64 + b] != WALL) << b;
+            }
+            words[w] = word;
+        }
+    }
+}
+
+int get_bitboard_bit(const bitboard_t* board, const int x, const int y) {
+    if (x < 0 || x >= board->width || y < 0 || y >= board->height) return 0;
+    return (int) (board->bits[x * board->words + y / 64] >> (y % 64) & 1);
+}
+
+void set_bitboard_bit(const bitboard_t* board, const int x, const int y, const int value) {
+    if (x < 0 || x >= board->width || y < 0 || y >= board->height) return;
+    const uint64_t bit = (uint64_t) 1 << (y % 64);
+    if (value) {
+        board->bits[x * board->words + y / 64] |= bit;
+    } else {
+        board->bits[x * board->words + y / 64] &= ~bit;
+    }
+}
+
+int count_bitboard(const bitboard_t* board) {
+    int count = 0;
+    for (int i = 0; i < board->width * board->words; i++) {
+        count += __builtin_popcountll(board->bits[i]);
+    }
+    return count;
+}
+
+int bitboard_to_list(const bitboard_t* board, vector2d_t* list, const int max_length) {
+    int length = 0;
+    for (int x = 0; x < board->width; x++) {
+        for (int w = 0; w < board->words; w++) {
+            uint64_t word = board->bits[x * board->words + w];
+            while (word != 0 && length < max_length) {
+                list[length++] = (vector2d_t) {x, w * 64 + __builtin_ctzll(word)};
+                word &= word - 1;// clear the lowest set bit
+            }
+        }
+    }
+    return length;
+}
+
+void count_neighbours_bitboard(const bitboard_t* open, const bitboard_t counts[3]) {
+    for (int x = 0; x < open->width; x++) {
+        for (int w = 0; w < open->words; w++) {
+            const neighbour_words_t n = get_neighbour_words(open, x, w);
+
+            // bit-sliced addition of the four neighbour bits
+            const uint64_t sum_ud = n.up ^ n.down;
+            const uint64_t carry_ud = n.up & n.down;
+            const uint64_t sum_lr = n.left ^ n.right;
+            const uint64_t carry_lr = n.left & n.right;
+            const uint64_t carry = sum_ud & sum_lr;
+
+            const int idx = x * open->words + w;
+            counts[0].bits[idx] = sum_ud ^ sum_lr;
+            counts[1].bits[idx] = carry_ud ^ carry_lr ^ carry;
+            counts[2].bits[idx] = (carry_ud & carry_lr) | (carry_ud & carry) | (carry_lr & carry);
+        }
+    }
+}
+
+void find_dead_ends_bitboard(const bitboard_t* open, const bitboard_t* dead_ends) {
+    for (int x = 0; x < open->width; x++) {
+        for (int w = 0; w < open->words; w++) {
+            const neighbour_words_t n = get_neighbour_words(open, x, w);
+
+            // exactly one of the four neighbours is open
+            const uint64_t odd = n.up ^ n.down ^ n.left ^ n.right;
+            const uint64_t more_than_one = (n.up & n.down) | (n.left & n.right) | ((n.up | n.down) & (n.left | n.right));
+
+            const int idx = x * open->words + w;
+            dead_ends->bits[idx] = open->bits[idx] & odd & ~more_than_one;
+        }
+    }
+}
+
+void find_loop_candidates_bitboard(const bitboard_t* open, const bitboard_t* candidates) {
+    for (int x = 0; x < open->width; x++) {
+        for (int w = 0; w < open->words; w++) {
+            const int idx = x * open->words + w;
+            if (x == 0 || x == open->width - 1) {
+                candidates->bits[idx] = 0;// the outer walls are never knocked down
+                continue;
+            }
+            const neighbour_words_t n = get_neighbour_words(open, x, w);
+
+            const uint64_t vertical = n.up & n.down & ~n.left & ~n.right;
+            const uint64_t horizontal = n.left & n.right & ~n.up & ~n.down;
+
+            uint64_t inner = valid_word_mask(open, w);
+            if (w == 0) inner &= ~(uint64_t) 1;
+            if (w == (open->height - 1) / 64) inner &= ~((uint64_t) 1 << ((open->height - 1) % 64));
+
+            candidates->bits[idx] = ~open->bits[idx] & (vertical | horizontal) & inner;
+        }
+    }
+}
+
+void step_cave_bitboard(const bitboard_t* walls, const bitboard_t* next) {
+    for (int x = 0; x < walls->width; x++) {
+        for (int w = 0; w < walls->words; w++) {
+            const int idx = x * walls->words + w;
+            const uint64_t mask = valid_word_mask(walls, w);
+            if (x == 0 || x == walls->width - 1) {
+                next->bits[idx] = mask;// the outer walls always stay
+                continue;
+            }
+            const neighbour_words_t n = get_neighbour_words(walls, x, w);
+            const uint64_t up_left = get_up_word(walls, x - 1, w);
+            const uint64_t down_left = get_down_word(walls, x - 1, w);
+            const uint64_t up_right = get_up_word(walls, x + 1, w);
+            const uint64_t down_right = get_down_word(walls, x + 1, w);
+
+            // bit-sliced addition of the eight neighbour bits with carry-save adders
+            const uint64_t sum_a = n.up ^ n.down ^ n.left;
+            const uint64_t carry_a = (n.up & n.down) | (n.up & n.left) | (n.down & n.left);
+            const uint64_t sum_b = n.right ^ up_left ^ down_left;
+            const uint64_t carry_b = (n.right & up_left) | (n.right & down_left) | (up_left & down_left);
+            const uint64_t sum_c = up_right ^ down_right;
+            const uint64_t carry_c = up_right & down_right;
+
+            const uint64_t bit0 = sum_a ^ sum_b ^ sum_c;
+            const uint64_t carry_ones = (sum_a & sum_b) | (sum_a & sum_c) | (sum_b & sum_c);
+            const uint64_t sum_twos = carry_a ^ carry_b ^ carry_c;
+            const uint64_t carry_twos = (carry_a & carry_b) | (carry_a & carry_c) | (carry_b & carry_c);
+            const uint64_t bit1 = sum_twos ^ carry_ones;
+            const uint64_t carry_fours = sum_twos & carry_ones;
+            const uint64_t bit2 = carry_twos ^ carry_fours;
+            const uint64_t bit3 = carry_twos & carry_fours;
+
+            const uint64_t at_least_four = bit3 | bit2;
+            const uint64_t at_least_five = bit3 | (bit2 & (bit1 | bit0));
+
+            uint64_t word = (walls->bits[idx] & at_least_four) | (~walls->bits[idx] & at_least_five);
+            if (w == 0) word |= 1;// top wall
+            if (w == (walls->height - 1) / 64) word |= (uint64_t) 1 << ((walls->height - 1) % 64);// bottom wall
+            next->bits[idx] = word & mask;
+        }
+    }
+}
+
+int is_loop_candidate(const bitboard_t* open, const int x, const int y) {
+    if (x <= 0 || x >= open->width - 1 || y <= 0 || y >= open->height - 1) return 0;
+    if (get_bitboard_bit(open, x, y)) return 0;
+
+    const int up = get_bitboard_bit(open, x, y - 1);
+    const int down = get_bitboard_bit(open, x, y + 1);
+    const int left = get_bitboard_bit(open, x - 1, y);
+    const int right = get_bitboard_bit(open, x + 1, y);
+    return (up && down && !left && !right) || (left && right && !up && !down);
+}
+
+neighbour_words_t get_neighbour_words(const bitboard_t* board, const int x, const int w) {
+    const uint64_t* column = board->bits + x * board->words;
+
+    neighbour_words_t n;
+    n.up = get_up_word(board, x, w);
+    n.down = get_down_word(board, x, w);
+    n.left = x > 0 ? column[w - board->words] : 0;
+    n.right = x + 1 < board->width ? column[w + board->words] : 0;
+    return n;
+}
+
+uint64_t get_up_word(const bitboard_t* board, const int x, const int w) {
+    if (x < 0 || x >= board->width) return 0;
+    const uint64_t* column = board->bits + x * board->words;
+    return (column[w] << 1 | (w > 0 ? column[w - 1] >> 63 : 0)) & valid_word_mask(board, w);
+}
+
+uint64_t get_down_word(const bitboard_t* board, const int x, const int w) {
+    if (x < 0 || x >= board->width) return 0;
+    const uint64_t* column = board->bits + x * board->words;
+    return column[w] >> 1 | (w + 1 < board->words ? column[w + 1] << 63 : 0);
+}
+
+uint64_t valid_word_mask(const bitboard_t* board, const int w) {
+    const int bits = board->height - w * 64;
+    return bits >= 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << bits) - 1;
+}
@@ -0,0 +1,105 @@
+#ifndef MAP_BITBOARD_H
+#define MAP_BITBOARD_H
+
+#include "map.h"
+
+#include <stdint.h>
+
+#define BITBOARD_WORDS(height) (((height) + 63) / 64)
+#define BITBOARD_SIZE(width, height) ((width) * BITBOARD_WORDS(height))
+
+/**
+ * A bit per map tile, stored column by column like the map tiles. Each column occupies `words`
+ * 64-bit words, bit (y % 64) of the word (x * words + y / 64) represents the tile (x, y).
+ * Vertical neighbours are reached by shifting a column, horizontal neighbours are the
+ * adjacent columns, so a whole column is classified with a few word operations.
+ * The storage is provided by the caller, so bitboards can live on the stack of worker threads.
+ */
+typedef struct {
+    int width;
+    int height;
+    int words;     // words per column
+    uint64_t* bits;// BITBOARD_SIZE(width, height) words
+} bitboard_t;
+
+/**
+ * Initializes the bitboard on the given storage and clears all bits.
+ *
+ * @param board The bitboard to initialize.
+ * @param bits The storage, at least BITBOARD_SIZE(width, height) words.
+ * @param width The width of the map.
+ * @param height The height of the map.
+ */
+void init_bitboard(bitboard_t* board, uint64_t* bits, int width, int height);
+
+/**
+ * Sets the bit of every tile that is not a WALL, all other bits are cleared.
+ *
+ * @param board The initialized bitboard.
+ * @param tiles The column major tiles, with the dimensions of the bitboard.
+ */
+void fill_open_bitboard(const bitboard_t* board, const map_tile_t* tiles);
+
+int get_bitboard_bit(const bitboard_t* board, int x, int y);
+
+void set_bitboard_bit(const bitboard_t* board, int x, int y, int value);
+
+/**
+ * @return The number of set bits in the bitboard.
+ */
+int count_bitboard(const bitboard_t* board);
+
+/**
+ * Writes the positions of the set bits into the list, column by column.
+ *
+ * @param board The bitboard to read.
+ * @param list The output list.
+ * @param max_length The capacity of the list.
+ * @return The number of written positions.
+ */
+int bitboard_to_list(const bitboard_t* board, vector2d_t* list, int max_length);
+
+/**
+ * Counts the open 4-neighbours of every tile as a bit-sliced number,
+ * count = bit0 + 2 * bit1 + 4 * bit2.
+ *
+ * @param open The bitboard of open (non-wall) tiles.
+ * @param counts Three bitboards with the dimensions of `open`, receiving bit 0, 1 and 2 of the counts.
+ */
+void count_neighbours_bitboard(const bitboard_t* open, const bitboard_t counts[3]);
+
+/**
+ * Marks every open tile with exactly one open 4-neighbour.
+ *
+ * @param open The bitboard of open (non-wall) tiles.
+ * @param dead_ends The bitboard receiving the dead ends, with the dimensions of `open`.
+ */
+void find_dead_ends_bitboard(const bitboard_t* open, const bitboard_t* dead_ends);
+
+/**
+ * Marks every inner wall that lies between two opposing open tiles, while the other two
+ * neighbours are walls. Knocking down such a wall creates a loop in a maze.
+ *
+ * @param open The bitboard of open (non-wall) tiles.
+ * @param candidates The bitboard receiving the candidates, with the dimensions of `open`.
+ */
+void find_loop_candidates_bitboard(const bitboard_t* open, const bitboard_t* candidates);
+
+/**
+ * Runs one step of the 4-5 cave automaton: a wall stays a wall with at least four wall 8-neighbours,
+ * any other tile becomes a wall with at least five. The outer border of the map is always a wall.
+ * The eight neighbours are summed bit-sliced, so 64 tiles of a column are updated at once.
+ *
+ * @param walls The bitboard of wall tiles.
+ * @param next The bitboard receiving the next generation, with the dimensions of `walls`.
+ */
+void step_cave_bitboard(const bitboard_t* walls, const bitboard_t* next);
+
+/**
+ * Checks a single tile for the condition of `find_loop_candidates_bitboard`.
+ *
+ * @return 1 if the tile is a loop candidate, 0 otherwise.
+ */
+int is_loop_candidate(const bitboard_t* open, int x, int y);
+
+#endif//MAP_BITBOARD_H
@@ -0,0 +1,130 @@
+#include "map_cave_generator.h"
+
+#include "../../logger/logger.h"
+#include "map_bitboard.h"
+#include "map_generator.h"
+#include "map_random.h"
+
+#include <stdlib.h>
+
+#define CAVE_WALL_CHANCE 45// percentage of walls in the initial noise
+#define CAVE_STEPS 4
+#define CAVE_ATTEMPTS 8     // the noise is rolled again, when the largest region is too small
+#define CAVE_MIN_REGION 3   // the largest region must cover at least 1 / CAVE_MIN_REGION of the inner area
+
+/**
+ * Fills the bitboard with random walls, the outer border is always a wall.
+ *
+ * @param walls The bitboard of walls to fill.
+ */
+void fill_cave_noise(const bitboard_t* walls);
+
+/**
+ * Turns all floor tiles that are not part of the largest connected region into walls.
+ *
+ * @param map The carved map.
+ * @param labels Scratch space for the region label of each tile, width * height entries.
+ * @param queue Scratch space for the flood fill, width * height entries.
+ * @param largest Receives a tile of the largest region, unchanged if there is no floor.
+ * @return The number of tiles in the largest region.
+ */
+int keep_largest_region(const map_t* map, int* labels, int* queue, vector2d_t* largest);
+
+void carve_cave(map_t* map) {
+    const int width = map->width;
+    const int height = map->height;
+
+    uint64_t bits[2][BITBOARD_SIZE(width, height)];
+    bitboard_t walls[2];
+    init_bitboard(&walls[0], bits[0], width, height);
+    init_bitboard(&walls[1], bits[1], width, height);
+
+    //labels and queue hold an int per tile, too much for the stack on large floors
+    const int area = width * height;
+    int* labels = malloc(2 * area * sizeof(int));
+    RETURN_WHEN_NULL(labels, , "Map Cave Generator", "Failed to allocate memory for the cave regions")
+    int* queue = labels + area;
+
+    vector2d_t largest = map->entry_pos;
+    for (int attempt = 0; attempt < CAVE_ATTEMPTS; attempt++) {
+        fill_cave_noise(&walls[0]);
+
+        //smooth the noise, each step writes the next generation into the other bitboard
+        int current = 0;
+        for (int step = 0; step < CAVE_STEPS; step++) {
+            step_cave_bitboard(&walls[current], &walls[1 - current]);
+            current = 1 - current;
+        }
+
+        //the outer walls are already set and keep the start door
+        for (int x = 1; x < width - 1; x++) {
+            for (int y = 1; y < height - 1; y++) {
+                map->hidden_tiles[x * height + y] = get_bitboard_bit(&walls[current], x, y) ? WALL : FLOOR;
+            }
+        }
+
+        if (keep_largest_region(map, labels, queue, &largest) * CAVE_MIN_REGION >= (width - 2) * (height - 2)) break;
+    }
+    free(labels);
+
+    carve_corridor(map, map->entry_pos, largest);
+}
+
+void fill_cave_noise(const bitboard_t* walls) {
+    for (int x = 0; x < walls->width; x++) {
+        for (int y = 0; y < walls->height; y++) {
+            const int border = x == 0 || y == 0 || x == walls->width - 1 || y == walls->height - 1;
+            set_bitboard_bit(walls, x, y, border || (int) (map_rand() % 100) < CAVE_WALL_CHANCE);
+        }
+    }
+}
+
+int keep_largest_region(const map_t* map, int* labels, int* queue, vector2d_t* largest) {
+    const int area = map->width * map->height;
+    for (int i = 0; i < area; i++) {
+        labels[i] = 0;
+    }
+
+    //label the regions with a breadth-first flood fill
+    int region_count = 0;
+    int best_label = 0;
+    int best_size = 0;
+    for (int i = 0; i < area; i++) {
+        if (labels[i] != 0 || map->hidden_tiles[i] != FLOOR) continue;
+
+        const int label = ++region_count;
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = i;
+        labels[i] = label;
+        while (head < tail) {
+            const int idx = queue[head++];
+            const int x = idx / map->height;
+            const int y = idx % map->height;
+            for (int d = 0; d < 4; d++) {
+                const int nx = x + directions[d].dx;
+                const int ny = y + directions[d].dy;
+                if (nx < 0 || nx >= map->width || ny < 0 || ny >= map->height) continue;
+
+                const int nidx = nx * map->height + ny;
+                if (labels[nidx] == 0 && map->hidden_tiles[nidx] == FLOOR) {
+                    labels[nidx] = label;
+                    queue[tail++] = nidx;
+                }
+            }
+        }
+
+        if (tail > best_size) {
+            best_size = tail;
+            best_label = label;
+            *largest = (vector2d_t) {i / map->height, i % map->height};
+        }
+    }
+
+    for (int i = 0; i < area; i++) {
+        if (map->hidden_tiles[i] == FLOOR && labels[i] != best_label) {
+            map->hidden_tiles[i] = WALL;
+        }
+    }
+    return best_size;
+}
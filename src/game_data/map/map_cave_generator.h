@@ -0,0 +1,14 @@
+#ifndef MAP_CAVE_GENERATOR_H
+#define MAP_CAVE_GENERATOR_H
+
+#include "map.h"
+
+/**
+ * Carves a cave with a cellular automaton. The map is filled with random walls and smoothed on a
+ * bitboard, afterward only the largest cave region is kept and connected to the entry.
+ *
+ * @param map The map to carve, all tiles must be walls and the entry position must be set.
+ */
+void carve_cave(map_t* map);
+
+#endif//MAP_CAVE_GENERATOR_H
@@ -0,0 +1,454 @@
+#include "map_chunks.h"
+
+#include "../../logger/logger.h"
+#include "map_generator.h"
+#include "map_random.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_TILE_IDX(x, y) ((x) * CHUNK_SIZE + (y))
+
+#define STANDARD_CHUNK_ENEMY_COUNT 4
+#define ENEMY_MIN_DISTANCE 3
+#define MAX_PLACEMENT_ATTEMPTS 32
+#define FOUNTAIN_CHANCE 4// one in FOUNTAIN_CHANCE chunks contains a fountain
+
+/**
+ * Allocates and generates the chunk at the given chunk coordinates.
+ *
+ * @param map The chunked map the chunk belongs to.
+ * @param cx The x-coordinate of the chunk in the chunk directory.
+ * @param cy The y-coordinate of the chunk in the chunk directory.
+ * @return The generated chunk, or NULL if the allocation failed.
+ */
+map_chunk_t* generate_chunk(const map_t* map, int cx, int cy);
+
+/**
+ * Carves a perfect maze over all cells of the chunk using an iterative depth-first search.
+ *
+ * @param chunk The chunk to carve, all tiles must be WALL.
+ */
+void carve_chunk(map_chunk_t* chunk);
+
+/**
+ * Knocks down random walls between two opposing floor tiles to create loops inside the chunk.
+ *
+ * @param chunk The carved chunk.
+ */
+void add_chunk_loops(map_chunk_t* chunk);
+
+/**
+ * Opens the left and top border of the chunk towards the neighbouring chunks and places the
+ * start door, if the chunk contains it.
+ *
+ * @param map The chunked map the chunk belongs to.
+ * @param chunk The carved chunk.
+ * @param cx The x-coordinate of the chunk in the chunk directory.
+ * @param cy The y-coordinate of the chunk in the chunk directory.
+ */
+void open_chunk_borders(const map_t* map, map_chunk_t* chunk, int cx, int cy);
+
+/**
+ * Places the key, the enemies and fountains in the chunk.
+ *
+ * @param map The chunked map the chunk belongs to.
+ * @param chunk The carved chunk.
+ * @param cx The x-coordinate of the chunk in the chunk directory.
+ * @param cy The y-coordinate of the chunk in the chunk directory.
+ */
+void populate_chunk(const map_t* map, map_chunk_t* chunk, int cx, int cy);
+
+/**
+ * @return The local coordinates of a random maze cell inside a chunk.
+ */
+vector2d_t random_chunk_cell(void);
+
+/**
+ * Checks if an enemy is within the minimum distance of the local position inside the chunk.
+ *
+ * @param chunk The chunk to check.
+ * @param x The local x-coordinate.
+ * @param y The local y-coordinate.
+ * @return 1 if an enemy is close, 0 otherwise.
+ */
+int is_close_to_chunk_enemy(const map_chunk_t* chunk, int x, int y);
+
+/**
+ * Checks if the local cell is a dead end (exactly one non-wall neighbour inside the chunk).
+ *
+ * @param chunk The chunk to check.
+ * @param x The local x-coordinate.
+ * @param y The local y-coordinate.
+ * @return 1 if it is a dead end, 0 otherwise.
+ */
+int is_chunk_dead_end(const map_chunk_t* chunk, int x, int y);
+
+int map_uses_chunks(const int width, const int height) {
+    return (long) width * height > CHUNKED_MAP_MIN_AREA;
+}
+
+map_chunks_t* create_map_chunks(const memory_pool_t* pool, const int width, const int height) {
+    RETURN_WHEN_NULL(pool, NULL, "Map Chunks", "Memory pool is NULL")
+    RETURN_WHEN_TRUE(width <= CHUNK_SIZE || height <= CHUNK_SIZE, NULL, "Map Chunks",
+                     "Map dimensions %dx%d are too small for chunks", width, height)
+
+    map_chunks_t* chunks = memory_pool_alloc(pool, sizeof(map_chunks_t));
+    RETURN_WHEN_NULL(chunks, NULL, "Map Chunks", "Failed to allocate memory for the chunk directory")
+
+    chunks->pool = pool;
+    chunks->chunks_x = (width - 1) / CHUNK_SIZE;
+    chunks->chunks_y = (height - 1) / CHUNK_SIZE;
+    chunks->generated_count = 0;
+    chunks->key_chunk = -1;
+    chunks->exit_door = (vector2d_t) {-1, -1};
+
+    const int count = chunks->chunks_x * chunks->chunks_y;
+    chunks->chunks = memory_pool_alloc(pool, count * sizeof(map_chunk_t*));
+    RETURN_WHEN_NULL_CLEAN(chunks->chunks, NULL, memory_pool_free(pool, chunks),
+                           "Map Chunks", "Failed to allocate memory for %d chunk pointers", count)
+    for (int i = 0; i < count; i++) {
+        chunks->chunks[i] = NULL;
+    }
+    return chunks;
+}
+
+void destroy_map_chunks(map_chunks_t* chunks) {
+    RETURN_WHEN_NULL(chunks, , "Map Chunks", "In `destroy_map_chunks` chunks are NULL")
+
+    const memory_pool_t* pool = chunks->pool;
+    for (int i = 0; i < chunks->chunks_x * chunks->chunks_y; i++) {
+        if (chunks->chunks[i] != NULL) memory_pool_free(pool, chunks->chunks[i]);
+    }
+    memory_pool_free(pool, chunks->chunks);
+    memory_pool_free(pool, chunks);
+}
+
+int init_chunked_map(const memory_pool_t* pool, map_t* map, const int generate_exit) {
+    RETURN_WHEN_NULL(pool, 1, "Map Chunks", "Memory pool is NULL")
+    RETURN_WHEN_NULL(map, 1, "Map Chunks", "Map to initialize is NULL")
+
+    // round the dimensions up to whole chunks plus the virtual outer wall
+    map->width = (map->width - 1 + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SIZE + 1;
+    map->height = (map->height - 1 + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SIZE + 1;
+    map->hidden_tiles = NULL;
+    map->revealed_mask = NULL;
+    map->exit_unlocked = 0;
+    if (map->enemy_count <= 0) {
+        map->enemy_count = STANDARD_CHUNK_ENEMY_COUNT;
+    }
+
+    map->chunks = create_map_chunks(pool, map->width, map->height);
+    RETURN_WHEN_NULL(map->chunks, 1, "Map Chunks", "Failed to create the chunk directory")
+    map_chunks_t* chunks = map->chunks;
+
+    // the entry is always on the left outer wall, the exit on the right (virtual) outer wall
+    const int entry_y = 1 + 2 * (map_rand() % ((map->height - 1) / 2));
+    map->player_pos = (vector2d_t) {1, entry_y};
+    map->entry_pos = map->player_pos;
+
+    if (generate_exit) {
+        const int exit_y = 1 + 2 * (map_rand() % ((map->height - 1) / 2));
+        chunks->exit_door = (vector2d_t) {map->width - 1, exit_y};
+        map->exit_pos = (vector2d_t) {map->width - 2, exit_y};
+    } else {
+        map->exit_pos = (vector2d_t) {-1, -1};
+    }
+
+    // the key is placed in a random chunk, different from the entry chunk when possible
+    const int count = chunks->chunks_x * chunks->chunks_y;
+    const int entry_chunk = entry_y / CHUNK_SIZE;
+    chunks->key_chunk = map_rand() % count;
+    while (count > 1 && chunks->key_chunk == entry_chunk) {
+        chunks->key_chunk = map_rand() % count;
+    }
+
+    // only the chunk around the player is generated now
+    RETURN_WHEN_NULL(get_map_chunk(map, map->player_pos.dx, map->player_pos.dy, 1), 1,
+                     "Map Chunks", "Failed to generate the entry chunk")
+    return 0;
+}
+
+map_chunk_t* get_map_chunk(const map_t* map, const int x, const int y, const int generate) {
+    map_chunks_t* chunks = map->chunks;
+    const int cx = x / CHUNK_SIZE;
+    const int cy = y / CHUNK_SIZE;
+    if (cx >= chunks->chunks_x || cy >= chunks->chunks_y) return NULL;// virtual outer wall
+
+    const int chunk_idx = cx * chunks->chunks_y + cy;
+    if (chunks->chunks[chunk_idx] == NULL && generate) {
+        chunks->chunks[chunk_idx] = generate_chunk(map, cx, cy);
+    }
+    return chunks->chunks[chunk_idx];
+}
+
+map_tile_t get_chunked_hidden_tile(const map_t* map, const int x, const int y) {
+    const map_chunk_t* chunk = get_map_chunk(map, x, y, 1);
+    if (chunk == NULL) {
+        const vector2d_t exit_door = map->chunks->exit_door;
+        return x == exit_door.dx && y == exit_door.dy ? EXIT_DOOR : WALL;
+    }
+    return chunk->hidden_tiles[CHUNK_TILE_IDX(x % CHUNK_SIZE, y % CHUNK_SIZE)];
+}
+
+map_tile_t get_chunked_revealed_tile(const map_t* map, const int x, const int y) {
+    if (x == map->width - 1 || y == map->height - 1) {
+        // the virtual outer wall is revealed together with the inner tile next to it
+        const int inner_x = x == map->width - 1 ? x - 1 : x;
+        const int inner_y = y == map->height - 1 ? y - 1 : y;
+        if (get_chunked_revealed_tile(map, inner_x, inner_y) == HIDDEN) return HIDDEN;
+        return get_chunked_hidden_tile(map, x, y);
+    }
+
+    const map_chunk_t* chunk = get_map_chunk(map, x, y, 0);
+    if (chunk == NULL) return HIDDEN;
+    const int index = CHUNK_TILE_IDX(x % CHUNK_SIZE, y % CHUNK_SIZE);
+    return IS_REVEALED(chunk->revealed_mask, index) ? chunk->hidden_tiles[index] : HIDDEN;
+}
+
+void set_chunked_hidden_tile(const map_t* map, const int x, const int y, const map_tile_t tile) {
+    map_chunk_t* chunk = get_map_chunk(map, x, y, 1);
+    if (chunk == NULL) return;
+    chunk->hidden_tiles[CHUNK_TILE_IDX(x % CHUNK_SIZE, y % CHUNK_SIZE)] = tile;
+}
+
+void set_chunked_revealed(const map_t* map, const int x, const int y, const int revealed) {
+    map_chunk_t* chunk = get_map_chunk(map, x, y, 0);
+    if (chunk == NULL) return;// nothing to reveal in a chunk that doesn't exist yet
+    const int index = CHUNK_TILE_IDX(x % CHUNK_SIZE, y % CHUNK_SIZE);
+    if (revealed) {
+        SET_REVEALED(chunk->revealed_mask, index);
+    } else {
+        CLEAR_REVEALED(chunk->revealed_mask, index);
+    }
+}
+
+int count_chunked_revealed(const map_chunks_t* chunks) {
+    int count = 0;
+    for (int i = 0; i < chunks->chunks_x * chunks->chunks_y; i++) {
+        if (chunks->chunks[i] == NULL) continue;
+        for (int j = 0; j < MASK_WORDS(CHUNK_AREA); j++) {
+            count += __builtin_popcountll(chunks->chunks[i]->revealed_mask[j]);
+        }
+    }
+    return count;
+}
+
+map_chunk_t* generate_chunk(const map_t* map, const int cx, const int cy) {
+    map_chunks_t* chunks = map->chunks;
+
+    map_chunk_t* chunk = memory_pool_alloc(chunks->pool, sizeof(map_chunk_t));
+    RETURN_WHEN_NULL(chunk, NULL, "Map Chunks", "Failed to allocate memory for chunk (%d, %d)", cx, cy)
+
+    for (int i = 0; i < CHUNK_AREA; i++) {
+        chunk->hidden_tiles[i] = WALL;
+    }
+    memset(chunk->revealed_mask, 0, sizeof(chunk->revealed_mask));
+
+    carve_chunk(chunk);
+    add_chunk_loops(chunk);
+    open_chunk_borders(map, chunk, cx, cy);
+    populate_chunk(map, chunk, cx, cy);
+
+    chunks->generated_count++;
+    log_msg(FINE, "Map Chunks", "Generated chunk (%d, %d), %d of %d chunks generated",
+            cx, cy, chunks->generated_count, chunks->chunks_x * chunks->chunks_y);
+    return chunk;
+}
+
+void carve_chunk(map_chunk_t* chunk) {
+    // the cell (cx, cy) lies on the local tile (2 * cx + 1, 2 * cy + 1)
+    int visited[CHUNK_CELLS * CHUNK_CELLS] = {0};
+    vector2d_t stack[CHUNK_CELLS * CHUNK_CELLS];
+    int top = 0;
+
+    const int start = map_rand() % (CHUNK_CELLS * CHUNK_CELLS);
+    stack[top++] = (vector2d_t) {start / CHUNK_CELLS, start % CHUNK_CELLS};
+    visited[start] = 1;
+    chunk->hidden_tiles[CHUNK_TILE_IDX(2 * stack[0].dx + 1, 2 * stack[0].dy + 1)] = FLOOR;
+
+    while (top > 0) {
+        const vector2d_t current = stack[top - 1];
+
+        vector2d_t candidates[4];
+        int candidate_count = 0;
+        for (int i = 0; i < 4; i++) {
+            const int nx = current.dx + directions[i].dx;
+            const int ny = current.dy + directions[i].dy;
+            if (nx >= 0 && nx < CHUNK_CELLS && ny >= 0 && ny < CHUNK_CELLS && !visited[nx * CHUNK_CELLS + ny]) {
+                candidates[candidate_count++] = directions[i];
+            }
+        }
+
+        if (candidate_count == 0) {
+            top--;// backtracking
+            continue;
+        }
+
+        const vector2d_t dir = candidates[map_rand() % candidate_count];
+        const int nx = current.dx + dir.dx;
+        const int ny = current.dy + dir.dy;
+
+        // make the wall between both cells and the next cell a floor
+        chunk->hidden_tiles[CHUNK_TILE_IDX(2 * current.dx + 1 + dir.dx, 2 * current.dy + 1 + dir.dy)] = FLOOR;
+        chunk->hidden_tiles[CHUNK_TILE_IDX(2 * nx + 1, 2 * ny + 1)] = FLOOR;
+        visited[nx * CHUNK_CELLS + ny] = 1;
+        stack[top++] = (vector2d_t) {nx, ny};
+    }
+}
+
+void add_chunk_loops(map_chunk_t* chunk) {
+    // the candidates exclude the outer tiles, so the borders towards the neighbours stay intact
+    add_map_loops(chunk->hidden_tiles, CHUNK_SIZE, CHUNK_SIZE, CHUNK_AREA / 100 + 1);
+}
+
+void open_chunk_borders(const map_t* map, map_chunk_t* chunk, const int cx, const int cy) {
+    // every chunk connects itself to its left and top neighbour through its own border column / row,
+    // this way the neighbours never need to agree on the openings
+    if (cx > 0) {
+        chunk->hidden_tiles[CHUNK_TILE_IDX(0, 2 * (map_rand() % CHUNK_CELLS) + 1)] = FLOOR;
+    }
+    if (cy > 0) {
+        chunk->hidden_tiles[CHUNK_TILE_IDX(2 * (map_rand() % CHUNK_CELLS) + 1, 0)] = FLOOR;
+    }
+
+    if (cx == 0 && map->entry_pos.dy / CHUNK_SIZE == cy) {
+        chunk->hidden_tiles[CHUNK_TILE_IDX(0, map->entry_pos.dy % CHUNK_SIZE)] = START_DOOR;
+    }
+}
+
+void populate_chunk(const map_t* map, map_chunk_t* chunk, const int cx, const int cy) {
+    const map_chunks_t* chunks = map->chunks;
+
+    if (cx * chunks->chunks_y + cy == chunks->key_chunk) {
+        // prefer a dead end for the key, but take any cell if none is found
+        vector2d_t key = random_chunk_cell();
+        for (int i = 0; i < MAX_PLACEMENT_ATTEMPTS && !is_chunk_dead_end(chunk, key.dx, key.dy); i++) {
+            key = random_chunk_cell();
+        }
+        chunk->hidden_tiles[CHUNK_TILE_IDX(key.dx, key.dy)] = DOOR_KEY;
+        DEBUG_LOG("Map Chunks", "Key placed at %d, %d", cx * CHUNK_SIZE + key.dx, cy * CHUNK_SIZE + key.dy);
+    }
+
+    for (int i = 0; i < map->enemy_count; i++) {
+        for (int attempt = 0; attempt < MAX_PLACEMENT_ATTEMPTS; attempt++) {
+            const vector2d_t pos = random_chunk_cell();
+            const int dist_x = abs(cx * CHUNK_SIZE + pos.dx - map->entry_pos.dx);
+            const int dist_y = abs(cy * CHUNK_SIZE + pos.dy - map->entry_pos.dy);
+
+            if ((dist_x > ENEMY_MIN_DISTANCE || dist_y > ENEMY_MIN_DISTANCE) &&
+                chunk->hidden_tiles[CHUNK_TILE_IDX(pos.dx, pos.dy)] == FLOOR &&
+                !is_close_to_chunk_enemy(chunk, pos.dx, pos.dy)) {
+                chunk->hidden_tiles[CHUNK_TILE_IDX(pos.dx, pos.dy)] = ENEMY;
+                break;
+            }
+        }
+    }
+
+    if (map_rand() % FOUNTAIN_CHANCE == 0) {
+        for (int attempt = 0; attempt < MAX_PLACEMENT_ATTEMPTS; attempt++) {
+            const vector2d_t pos = random_chunk_cell();
+            if (chunk->hidden_tiles[CHUNK_TILE_IDX(pos.dx, pos.dy)] == FLOOR) {
+                chunk->hidden_tiles[CHUNK_TILE_IDX(pos.dx, pos.dy)] = map_rand() % 2 ? LIFE_FOUNTAIN : MANA_FOUNTAIN;
+                break;
+            }
+        }
+    }
+}
+
+vector2d_t random_chunk_cell(void) {
+    return (vector2d_t) {2 * (map_rand() % CHUNK_CELLS) + 1, 2 * (map_rand() % CHUNK_CELLS) + 1};
+}
+
+int is_close_to_chunk_enemy(const map_chunk_t* chunk, const int x, const int y) {
+    for (int i = x - ENEMY_MIN_DISTANCE; i <= x + ENEMY_MIN_DISTANCE; i++) {
+        for (int j = y - ENEMY_MIN_DISTANCE; j <= y + ENEMY_MIN_DISTANCE; j++) {
+            if (i < 0 || i >= CHUNK_SIZE || j < 0 || j >= CHUNK_SIZE) continue;
+            if (chunk->hidden_tiles[CHUNK_TILE_IDX(i, j)] == ENEMY) return 1;
+        }
+    }
+    return 0;
+}
+
+int is_chunk_dead_end(const map_chunk_t* chunk, const int x, const int y) {
+    int neighbor_count = 0;
+    for (int i = 0; i < 4; i++) {
+        const int nx = x + directions[i].dx;
+        const int ny = y + directions[i].dy;
+        if (nx < 0 || nx >= CHUNK_SIZE || ny < 0 || ny >= CHUNK_SIZE) continue;
+        if (chunk->hidden_tiles[CHUNK_TILE_IDX(nx, ny)] != WALL) neighbor_count++;
+    }
+    return neighbor_count == 1;
+}
+
+int write_map_chunks(FILE* file, const map_chunks_t* chunks) {
+    RETURN_WHEN_NULL(file, 1, "Map Chunks", "In `write_map_chunks` file is NULL")
+    RETURN_WHEN_NULL(chunks, 1, "Map Chunks", "In `write_map_chunks` chunks are NULL")
+
+    fwrite(&chunks->key_chunk, sizeof(int), 1, file);
+    fwrite(&chunks->exit_door, sizeof(vector2d_t), 1, file);
+
+    for (int i = 0; i < chunks->chunks_x * chunks->chunks_y; i++) {
+        // a flag for each chunk, only generated chunks are written
+        const int generated = chunks->chunks[i] != NULL;
+        fwrite(&generated, sizeof(int), 1, file);
+        if (!generated) continue;
+
+        // the revealed tiles are stored as tiles, read through the revealed mask
+        map_tile_t revealed_tiles[CHUNK_AREA];
+        expand_revealed_tiles(chunks->chunks[i]->hidden_tiles, chunks->chunks[i]->revealed_mask, 0, CHUNK_AREA,
+                              revealed_tiles);
+        fwrite(chunks->chunks[i]->hidden_tiles, sizeof(map_tile_t), CHUNK_AREA, file);
+        fwrite(revealed_tiles, sizeof(map_tile_t), CHUNK_AREA, file);
+    }
+    return 0;
+}
+
+int read_map_chunks(FILE* file, map_chunks_t* chunks) {
+    RETURN_WHEN_NULL(file, 1, "Map Chunks", "In `read_map_chunks` file is NULL")
+    RETURN_WHEN_NULL(chunks, 1, "Map Chunks", "In `read_map_chunks` chunks are NULL")
+
+    RETURN_WHEN_TRUE(fread(&chunks->key_chunk, sizeof(int), 1, file) != 1, 1,
+                     "Map Chunks", "Failed to read the key chunk")
+    RETURN_WHEN_TRUE(fread(&chunks->exit_door, sizeof(vector2d_t), 1, file) != 1, 1,
+                     "Map Chunks", "Failed to read the exit door")
+
+    for (int i = 0; i < chunks->chunks_x * chunks->chunks_y; i++) {
+        int generated;
+        RETURN_WHEN_TRUE(fread(&generated, sizeof(int), 1, file) != 1, 1,
+                         "Map Chunks", "Failed to read the flag of chunk %d", i)
+        if (!generated) continue;
+
+        map_chunk_t* chunk = memory_pool_alloc(chunks->pool, sizeof(map_chunk_t));
+        RETURN_WHEN_NULL(chunk, 1, "Map Chunks", "Failed to allocate memory for chunk %d", i)
+        chunks->chunks[i] = chunk;// owned by the directory from now on
+        chunks->generated_count++;
+
+        RETURN_WHEN_TRUE(fread(chunk->hidden_tiles, sizeof(map_tile_t), CHUNK_AREA, file) != CHUNK_AREA, 1,
+                         "Map Chunks", "Failed to read the hidden tiles of chunk %d", i)
+        map_tile_t revealed_tiles[CHUNK_AREA];
+        RETURN_WHEN_TRUE(fread(revealed_tiles, sizeof(map_tile_t), CHUNK_AREA, file) != CHUNK_AREA, 1,
+                         "Map Chunks", "Failed to read the revealed tiles of chunk %d", i)
+        memset(chunk->revealed_mask, 0, sizeof(chunk->revealed_mask));
+        merge_revealed_tiles(revealed_tiles, 0, CHUNK_AREA, chunk->revealed_mask);
+    }
+    return 0;
+}
+
+long calculate_checksum_chunks(const map_chunks_t* chunks) {
+    long checksum = 0;
+
+    checksum += chunks->key_chunk;
+    checksum += chunks->exit_door.dx;
+    checksum += chunks->exit_door.dy;
+
+    for (int i = 0; i < chunks->chunks_x * chunks->chunks_y; i++) {
+        if (chunks->chunks[i] == NULL) continue;
+        const map_chunk_t* chunk = chunks->chunks[i];
+        for (int j = 0; j < CHUNK_AREA; j++) {
+            checksum += chunk->hidden_tiles[j];
+            checksum += IS_REVEALED(chunk->revealed_mask, j) ? chunk->hidden_tiles[j] : HIDDEN;
+        }
+    }
+    return checksum;
+}
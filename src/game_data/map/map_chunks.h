@@ -0,0 +1,128 @@
+#ifndef MAP_CHUNKS_H
+#define MAP_CHUNKS_H
+
+#include "../../memory/mem_mgmt.h"
+#include "map.h"
+
+#include <stdio.h>
+
+#define CHUNK_SIZE 32// tiles per chunk side, must be even so chunk borders fall on wall columns / rows
+#define CHUNK_AREA (CHUNK_SIZE * CHUNK_SIZE)
+#define CHUNK_CELLS (CHUNK_SIZE / 2)// maze cells per chunk side, the cells lay on the odd local coordinates
+
+#define CHUNKED_MAP_MIN_AREA (256 * 256)// maps with a larger area are stored in lazily generated chunks
+
+typedef struct {
+    map_tile_t hidden_tiles[CHUNK_AREA];  // local index: x * CHUNK_SIZE + y
+    uint64_t revealed_mask[MASK_WORDS(CHUNK_AREA)];// one bit per hidden tile, set if revealed
+} map_chunk_t;
+
+/**
+ * The chunk directory of a large map. Each chunk covers CHUNK_SIZE x CHUNK_SIZE tiles and is only
+ * generated when one of its tiles is accessed for the first time. Every chunk owns its left column
+ * and top row, so the last column / row of the map is a virtual outer wall that is not stored.
+ */
+struct map_chunks {
+    const memory_pool_t* pool;// the pool the chunks are allocated from
+    int chunks_x;             // number of chunks in x direction
+    int chunks_y;             // number of chunks in y direction
+    int generated_count;      // number of already generated chunks
+    int key_chunk;            // index of the chunk containing the key
+    vector2d_t exit_door;     // position of the exit door on the virtual outer wall, -1 if none
+    map_chunk_t** chunks;     // chunks_x * chunks_y pointers, NULL if the chunk is not generated yet
+};
+
+/**
+ * Checks if a map with the given dimensions is stored in chunks.
+ *
+ * @param width The width of the map.
+ * @param height The height of the map.
+ * @return 1 if the map is stored in chunks, 0 otherwise.
+ */
+int map_uses_chunks(int width, int height);
+
+/**
+ * Creates an empty chunk directory for a map with the given dimensions.
+ * The dimensions must already be normalized, so that (width - 1) and (height - 1)
+ * are multiples of CHUNK_SIZE.
+ *
+ * @param pool The memory pool used for the directory and all chunks generated later on.
+ * @param width The width of the map.
+ * @param height The height of the map.
+ * @return A pointer to the chunk directory, or NULL if the allocation failed.
+ */
+map_chunks_t* create_map_chunks(const memory_pool_t* pool, int width, int height);
+
+/**
+ * Frees the chunk directory and all generated chunks.
+ *
+ * @param chunks The chunk directory to destroy.
+ */
+void destroy_map_chunks(map_chunks_t* chunks);
+
+/**
+ * Initializes a chunked map. Rounds the dimensions up to whole chunks, sets the entry, exit and key
+ * locations and generates the chunk containing the entry. All other chunks are generated on demand.
+ *
+ * @param pool The memory pool used for the chunk allocations.
+ * @param map The map to initialize, width and height must be set.
+ * @param generate_exit Non-zero if the map should contain an exit door.
+ * @return 0 on success, 1 on failure.
+ */
+int init_chunked_map(const memory_pool_t* pool, map_t* map, int generate_exit);
+
+/**
+ * Returns the chunk containing the given tile, generating it when it doesn't exist yet.
+ *
+ * @param map The chunked map.
+ * @param x The x-coordinate of the tile, must be in bounds of the chunk directory.
+ * @param y The y-coordinate of the tile, must be in bounds of the chunk directory.
+ * @param generate If non-zero, a missing chunk is generated, otherwise NULL is returned for it.
+ * @return The chunk, or NULL if it isn't generated and `generate` is 0 or the generation failed.
+ */
+map_chunk_t* get_map_chunk(const map_t* map, int x, int y, int generate);
+
+map_tile_t get_chunked_hidden_tile(const map_t* map, int x, int y);
+
+map_tile_t get_chunked_revealed_tile(const map_t* map, int x, int y);
+
+void set_chunked_hidden_tile(const map_t* map, int x, int y, map_tile_t tile);
+
+void set_chunked_revealed(const map_t* map, int x, int y, int revealed);
+
+/**
+ * Counts the revealed tiles of all generated chunks.
+ *
+ * @param chunks The chunk directory.
+ * @return The number of revealed tiles.
+ */
+int count_chunked_revealed(const map_chunks_t* chunks);
+
+/**
+ * Writes the chunk directory and all generated chunks to the given file.
+ *
+ * @param file The file to write to.
+ * @param chunks The chunk directory to write.
+ * @return 0 on success, 1 on failure.
+ */
+int write_map_chunks(FILE* file, const map_chunks_t* chunks);
+
+/**
+ * Reads the chunk directory and all generated chunks from the given file.
+ * The chunk directory must already be created with the dimensions of the map.
+ *
+ * @param file The file to read from.
+ * @param chunks The chunk directory to fill.
+ * @return 0 on success, 1 on failure.
+ */
+int read_map_chunks(FILE* file, map_chunks_t* chunks);
+
+/**
+ * Calculates a checksum over all generated chunks.
+ *
+ * @param chunks The chunk directory.
+ * @return The checksum.
+ */
+long calculate_checksum_chunks(const map_chunks_t* chunks);
+
+#endif//MAP_CHUNKS_H
@@ -0,0 +1,166 @@
+#include "map_compression.h"
+
+#include "../../logger/logger.h"
+
+#define SHORT_RUN_MAX 15                  // runs up to this length fit into the low nibble
+#define LONG_RUN_MARKER 15                // low nibble of a run with an extra length byte
+#define LONG_RUN_MAX (SHORT_RUN_MAX + 256)// the extra byte stores the length - 16
+
+/**
+ * Run-length encodes the tiles. When `out` is NULL, only the encoded size is calculated.
+ *
+ * @param tiles The tiles to encode.
+ * @param count The number of tiles.
+ * @param out The output buffer or NULL.
+ * @return The number of encoded bytes.
+ */
+int encode_tiles(const map_tile_t* tiles, int count, unsigned char* out);
+
+/**
+ * Decodes `count` tiles starting at the given offset of the packed data.
+ *
+ * @param data The packed data.
+ * @param size The size of the packed data.
+ * @param offset The offset to start at, receives the offset after the decoded tiles.
+ * @param tiles The output tiles.
+ * @param count The number of tiles to decode.
+ * @return 0 on success, 1 if the data ended early or contains invalid tiles.
+ */
+int decode_tiles(const unsigned char* data, int size, int* offset, map_tile_t* tiles, int count);
+
+/**
+ * Reads the run starting at the given offset of the packed data.
+ *
+ * @param data The packed data.
+ * @param size The size of the packed data.
+ * @param offset The offset of the run, receives the offset of the next run.
+ * @param tile Receives the tile of the run.
+ * @param run Receives the length of the run.
+ * @return 0 on success, 1 if the data ended early or contains an invalid tile.
+ */
+int read_run(const unsigned char* data, int size, int* offset, map_tile_t* tile, int* run);
+
+int pack_map(const memory_pool_t* pool, map_t* map) {
+    RETURN_WHEN_NULL(pool, 1, "Map Compression", "Memory pool is NULL");
+    RETURN_WHEN_NULL(map, 1, "Map Compression", "Map is NULL");
+    if (map->chunks != NULL || map->packed_tiles != NULL) return 0;
+    RETURN_WHEN_TRUE(map->batch_owned, 1, "Map Compression", "Map %d belongs to a map batch and can't be packed",
+                     map->floor_nr);
+    RETURN_WHEN_NULL(map->hidden_tiles, 1, "Map Compression", "Map %d has no tiles to pack", map->floor_nr);
+
+    const int count = map->width * map->height;
+    const int size = encode_tiles(map->hidden_tiles, count, NULL);
+
+    unsigned char* packed = memory_pool_alloc(pool, size);
+    RETURN_WHEN_NULL(packed, 1, "Map Compression", "Failed to allocate memory for the packed tiles");
+    encode_tiles(map->hidden_tiles, count, packed);
+
+    memory_pool_free(pool, map->hidden_tiles);
+    map->hidden_tiles = NULL;
+    map->packed_tiles = packed;
+    map->packed_size = size;
+    return 0;
+}
+
+int unpack_map(const memory_pool_t* pool, map_t* map) {
+    RETURN_WHEN_NULL(pool, 1, "Map Compression", "Memory pool is NULL");
+    RETURN_WHEN_NULL(map, 1, "Map Compression", "Map is NULL");
+    if (map->packed_tiles == NULL) return 0;
+
+    const int count = map->width * map->height;
+    map_tile_t* hidden_tiles = memory_pool_alloc(pool, count * sizeof(map_tile_t));
+    packed_tiles_cursor_t cursor = {0};
+    if (hidden_tiles == NULL || unpack_map_tiles(map, &cursor, hidden_tiles, count) != 0) {
+        if (hidden_tiles != NULL) memory_pool_free(pool, hidden_tiles);
+        log_msg(ERROR, "Map Compression", "Failed to unpack map %d", map->floor_nr);
+        return 1;
+    }
+
+    memory_pool_free(pool, map->packed_tiles);
+    map->packed_tiles = NULL;
+    map->packed_size = 0;
+    map->hidden_tiles = hidden_tiles;
+    return 0;
+}
+
+int unpack_map_tiles(const map_t* map, packed_tiles_cursor_t* cursor, map_tile_t* hidden_tiles, const int count) {
+    RETURN_WHEN_NULL(map, 1, "Map Compression", "Map is NULL");
+    RETURN_WHEN_NULL(map->packed_tiles, 1, "Map Compression", "Map %d is not packed", map->floor_nr);
+
+    int i = 0;
+    while (i < count) {
+        if (cursor->remaining == 0) {
+            int run;
+            RETURN_WHEN_TRUE(read_run(map->packed_tiles, map->packed_size, &cursor->offset, &cursor->tile, &run) != 0 ||
+                                     cursor->position + run > map->width * map->height,
+                             1, "Map Compression", "Packed hidden tiles of map %d are corrupted", map->floor_nr);
+            cursor->position += run;
+            cursor->remaining = run;
+        }
+        const int decoded = cursor->remaining < count - i ? cursor->remaining : count - i;
+        for (int j = 0; j < decoded; j++) {
+            hidden_tiles[i + j] = cursor->tile;
+        }
+        cursor->remaining -= decoded;
+        i += decoded;
+    }
+    return 0;
+}
+
+int encode_tiles(const map_tile_t* tiles, const int count, unsigned char* out) {
+    int size = 0;
+    int i = 0;
+    while (i < count) {
+        const map_tile_t tile = tiles[i];
+        int run = 1;
+        while (i + run < count && tiles[i + run] == tile && run < LONG_RUN_MAX) {
+            run++;
+        }
+        i += run;
+
+        if (run <= SHORT_RUN_MAX) {
+            if (out != NULL) out[size] = (unsigned char) (tile << 4 | (run - 1));
+            size += 1;
+        } else {
+            if (out != NULL) {
+                out[size] = (unsigned char) (tile << 4 | LONG_RUN_MARKER);
+                out[size + 1] = (unsigned char) (run - SHORT_RUN_MAX - 1);
+            }
+            size += 2;
+        }
+    }
+    return size;
+}
+
+int decode_tiles(const unsigned char* data, const int size, int* offset, map_tile_t* tiles, const int count) {
+    int pos = *offset;
+    int i = 0;
+    while (i < count) {
+        map_tile_t tile;
+        int run;
+        if (read_run(data, size, &pos, &tile, &run) != 0 || i + run > count) return 1;
+
+        for (int j = 0; j < run; j++) {
+            tiles[i + j] = tile;
+        }
+        i += run;
+    }
+    *offset = pos;
+    return 0;
+}
+
+int read_run(const unsigned char* data, const int size, int* offset, map_tile_t* tile, int* run) {
+    int pos = *offset;
+    if (pos >= size) return 1;
+    *tile = data[pos] >> 4;
+    *run = (data[pos] & 0x0F) + 1;
+    pos++;
+    if (*run == LONG_RUN_MARKER + 1) {
+        if (pos >= size) return 1;
+        *run = data[pos] + SHORT_RUN_MAX + 1;
+        pos++;
+    }
+    if (*tile >= MAX_MAP_TILES) return 1;
+    *offset = pos;
+    return 0;
+}
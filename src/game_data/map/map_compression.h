@@ -0,0 +1,54 @@
+#ifndef MAP_COMPRESSION_H
+#define MAP_COMPRESSION_H
+
+#include "../../memory/mem_mgmt.h"
+#include "map.h"
+
+/**
+ * Position inside the packed hidden tiles of a map, so they can be decoded piece by piece with `unpack_map_tiles`.
+ * A zero initialized cursor starts at the first tile.
+ */
+typedef struct {
+    int offset;     // offset of the next run in the packed tiles
+    int position;   // index of the next tile
+    map_tile_t tile;// tile of the current run
+    int remaining;  // tiles of the current run which weren't decoded yet
+} packed_tiles_cursor_t;
+
+/**
+ * Compresses the tiles of an inactive floor. The hidden tiles are run-length encoded into a buffer
+ * from the pool, the tile array is freed and set to NULL afterward. The revealed mask is already
+ * compact and stays as it is.
+ * Each run is stored in one byte, the tile in the high nibble and the length in the low nibble,
+ * long runs take an extra length byte. Chunked and already packed maps are left unchanged.
+ * Maps of a map batch can't be packed, their tiles are part of the allocation of the batch.
+ *
+ * @param pool The memory pool the tiles were allocated from.
+ * @param map The map to pack.
+ * @return 0 on success or if there is nothing to pack, 1 on failure or for maps of a batch (the map stays unpacked).
+ */
+int pack_map(const memory_pool_t* pool, map_t* map);
+
+/**
+ * Restores the hidden tiles of a packed map and frees the packed buffer.
+ * Maps which are not packed are left unchanged.
+ *
+ * @param pool The memory pool used for the tiles.
+ * @param map The map to unpack.
+ * @return 0 on success or if the map wasn't packed, 1 on failure (the map stays packed).
+ */
+int unpack_map(const memory_pool_t* pool, map_t* map);
+
+/**
+ * Decodes the next hidden tiles of a packed map into the given array, without changing the map. Successive
+ * calls with the same cursor continue where the last one stopped, so a packed map can be read in blocks.
+ *
+ * @param map The packed map.
+ * @param cursor The position to decode from, advanced past the decoded tiles.
+ * @param hidden_tiles Receives `count` hidden tiles.
+ * @param count The number of tiles to decode, at most the number of tiles after the cursor.
+ * @return 0 on success, 1 if the packed data is corrupted.
+ */
+int unpack_map_tiles(const map_t* map, packed_tiles_cursor_t* cursor, map_tile_t* hidden_tiles, int count);
+
+#endif//MAP_COMPRESSION_H
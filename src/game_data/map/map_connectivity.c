@@ -0,0 +1,75 @@
+#include "map_connectivity.h"
+
+#include "../../logger/logger.h"
+
+/**
+ * Finds the representative of a tile's set, halving the path on the way.
+ *
+ * @param parent The parent of every tile.
+ * @param tile The index of the tile.
+ * @return The index of the representative.
+ */
+int find_tile_set(int* parent, int tile);
+
+/**
+ * Joins the sets of two tiles, the lower representative becomes the representative of both.
+ *
+ * @param parent The parent of every tile.
+ * @param a The index of the first tile.
+ * @param b The index of the second tile.
+ */
+void join_tile_sets(int* parent, int a, int b);
+
+int count_unreachable_tiles(const map_t* map) {
+    RETURN_WHEN_NULL(map, -1, "Map Connectivity", "Map is NULL");
+    RETURN_WHEN_TRUE(map->chunks != NULL || map->hidden_tiles == NULL, -1, "Map Connectivity",
+                     "Map %d must neither be chunked nor packed", map->floor_nr);
+    RETURN_WHEN_TRUE(map->entry_pos.dx < 0 || map->entry_pos.dx >= map->width || map->entry_pos.dy < 0 ||
+                             map->entry_pos.dy >= map->height,
+                     -1, "Map Connectivity", "Entry position of map %d is out of bounds", map->floor_nr);
+
+    const int height = map->height;
+    const int tile_count = map->width * height;
+    const map_tile_t* tiles = map->hidden_tiles;
+    int parent[tile_count];
+
+    for (int x = 0; x < map->width; x++) {
+        for (int y = 0; y < height; y++) {
+            const int tile = x * height + y;
+            if (tiles[tile] == WALL) {
+                parent[tile] = -1;
+                continue;
+            }
+            //a tile below an open tile continues its vertical run, only the left neighbour needs a real union
+            parent[tile] = y > 0 && parent[tile - 1] != -1 ? parent[tile - 1] : tile;
+            if (x > 0 && parent[tile - height] != -1) join_tile_sets(parent, tile - height, tile);
+        }
+    }
+
+    const int entry = map->entry_pos.dx * height + map->entry_pos.dy;
+    RETURN_WHEN_TRUE(parent[entry] == -1, -1, "Map Connectivity", "Entry of map %d is a wall", map->floor_nr);
+    const int root = find_tile_set(parent, entry);
+    int unreachable = 0;
+    for (int tile = 0; tile < tile_count; tile++) {
+        if (parent[tile] != -1 && find_tile_set(parent, tile) != root) unreachable++;
+    }
+    return unreachable;
+}
+
+int find_tile_set(int* parent, int tile) {
+    while (parent[tile] != tile) {
+        parent[tile] = parent[parent[tile]];
+        tile = parent[tile];
+    }
+    return tile;
+}
+
+void join_tile_sets(int* parent, const int a, const int b) {
+    const int root_a = find_tile_set(parent, a);
+    const int root_b = find_tile_set(parent, b);
+    if (root_a < root_b) {
+        parent[root_b] = root_a;
+    } else if (root_b < root_a) {
+        parent[root_a] = root_b;
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef MAP_CONNECTIVITY_H
+#define MAP_CONNECTIVITY_H
+
+#include "map.h"
+
+/**
+ * Counts the open tiles that can't be reached from the entry position. The open tiles are joined with
+ * their left and upper neighbours in a union-find over a single pass, so a standard floor is checked in
+ * a few microseconds. The union-find lives on the stack, so it can run inside the generation of worker threads.
+ * A map is valid when the result is 0, which includes the key, the exit and every enemy and fountain.
+ *
+ * @param map The map, must neither be chunked nor packed.
+ * @return The number of unreachable open tiles, or -1 if the map is invalid.
+ */
+int count_unreachable_tiles(const map_t* map);
+
+#endif//MAP_CONNECTIVITY_H
@@ -0,0 +1,139 @@
+#include "map_flow_field.h"
+
+#include "../../logger/logger.h"
+
+/**
+ * Makes sure the buffers can hold the given number of tiles, growing them if needed.
+ *
+ * @param field The flow field.
+ * @param tile_count The number of tiles.
+ * @return 0 on success, 1 if the allocation failed.
+ */
+int reserve_flow_field(flow_field_t* field, int tile_count);
+
+/**
+ * Runs the BFS from the source over all tiles except walls.
+ *
+ * @param field The flow field, with buffers large enough for the map.
+ * @param map The map.
+ * @param source The source tile.
+ */
+void compute_flow_field(flow_field_t* field, const map_t* map, vector2d_t source);
+
+flow_field_t* create_flow_field(const memory_pool_t* pool) {
+    RETURN_WHEN_NULL(pool, NULL, "Flow Field", "Memory pool is NULL");
+
+    flow_field_t* field = memory_pool_alloc(pool, sizeof(flow_field_t));
+    RETURN_WHEN_NULL(field, NULL, "Flow Field", "Failed to allocate memory for the flow field");
+    field->pool = pool;
+    field->capacity = 0;
+    field->distances = NULL;
+    field->queue = NULL;
+    field->width = 0;
+    field->height = 0;
+    field->source = (vector2d_t) {-1, -1};
+    field->tiles_version = 0;
+    return field;
+}
+
+void destroy_flow_field(flow_field_t* field) {
+    RETURN_WHEN_NULL(field, , "Flow Field", "In `destroy_flow_field` given field is NULL")
+    if (field->distances != NULL) memory_pool_free(field->pool, field->distances);
+    if (field->queue != NULL) memory_pool_free(field->pool, field->queue);
+    memory_pool_free(field->pool, field);
+}
+
+int update_flow_field(flow_field_t* field, const map_t* map, const vector2d_t source) {
+    RETURN_WHEN_NULL(field, 1, "Flow Field", "Flow field is NULL");
+    RETURN_WHEN_NULL(map, 1, "Flow Field", "Map is NULL");
+    RETURN_WHEN_TRUE(map->chunks != NULL || map->hidden_tiles == NULL, 1, "Flow Field",
+                     "Map %d must neither be chunked nor packed", map->floor_nr);
+    RETURN_WHEN_TRUE(source.dx < 0 || source.dx >= map->width || source.dy < 0 || source.dy >= map->height, 1,
+                     "Flow Field", "Source (%d, %d) is out of bounds", source.dx, source.dy);
+
+    if (field->tiles_version == map->tiles_version && field->source.dx == source.dx &&
+        field->source.dy == source.dy) {
+        //neither the source moved nor the tiles changed
+        return 0;
+    }
+    RETURN_WHEN_TRUE(reserve_flow_field(field, map->width * map->height) != 0, 1,
+                     "Flow Field", "Failed to allocate the buffers for map %d", map->floor_nr);
+
+    compute_flow_field(field, map, source);
+    field->width = map->width;
+    field->height = map->height;
+    field->source = source;
+    field->tiles_version = map->tiles_version;
+    return 0;
+}
+
+int get_flow_distance(const flow_field_t* field, const int x, const int y) {
+    if (field->tiles_version == 0 || x < 0 || x >= field->width || y < 0 || y >= field->height) {
+        return FLOW_UNREACHABLE;
+    }
+    return field->distances[x * field->height + y];
+}
+
+vector2d_t get_flow_direction(const flow_field_t* field, const int x, const int y) {
+    const int distance = get_flow_distance(field, x, y);
+    if (distance <= 0) return (vector2d_t) {0, 0};
+
+    for (int i = 0; i < 4; i++) {
+        if (get_flow_distance(field, x + directions[i].dx, y + directions[i].dy) == distance - 1) {
+            return directions[i];
+        }
+    }
+    return (vector2d_t) {0, 0};
+}
+
+int reserve_flow_field(flow_field_t* field, const int tile_count) {
+    if (tile_count <= field->capacity) return 0;
+
+    if (field->distances != NULL) memory_pool_free(field->pool, field->distances);
+    if (field->queue != NULL) memory_pool_free(field->pool, field->queue);
+    field->distances = memory_pool_alloc(field->pool, tile_count * sizeof(int));
+    field->queue = memory_pool_alloc(field->pool, tile_count * sizeof(int));
+    if (field->distances == NULL || field->queue == NULL) {
+        if (field->distances != NULL) memory_pool_free(field->pool, field->distances);
+        if (field->queue != NULL) memory_pool_free(field->pool, field->queue);
+        field->distances = NULL;
+        field->queue = NULL;
+        field->capacity = 0;
+        field->tiles_version = 0;
+        return 1;
+    }
+    field->capacity = tile_count;
+    return 0;
+}
+
+void compute_flow_field(flow_field_t* field, const map_t* map, const vector2d_t source) {
+    const int height = map->height;
+    const int tile_count = map->width * height;
+    const map_tile_t* tiles = map->hidden_tiles;
+    int* distances = field->distances;
+    int* queue = field->queue;
+
+    for (int i = 0; i < tile_count; i++) {
+        distances[i] = FLOW_UNREACHABLE;
+    }
+
+    const int source_index = source.dx * height + source.dy;
+    if (tiles[source_index] == WALL) return;
+    distances[source_index] = 0;
+    queue[0] = source_index;
+
+    int head = 0;
+    int tail = 1;
+    while (head < tail) {
+        const int index = queue[head++];
+        const int next_distance = distances[index] + 1;
+        int neighbours[4];
+        const int neighbour_count = get_neighbour_indices(map, index, neighbours);
+        for (int i = 0; i < neighbour_count; i++) {
+            const int neighbour = neighbours[i];
+            if (distances[neighbour] != FLOW_UNREACHABLE || tiles[neighbour] == WALL) continue;
+            distances[neighbour] = next_distance;
+            queue[tail++] = neighbour;
+        }
+    }
+}
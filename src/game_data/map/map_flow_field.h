@@ -0,0 +1,74 @@
+#ifndef MAP_FLOW_FIELD_H
+#define MAP_FLOW_FIELD_H
+
+#include "../../memory/mem_mgmt.h"
+#include "map.h"
+
+#define FLOW_UNREACHABLE (-1)// distance of walls and tiles that can't be reached from the source
+
+/**
+ * The BFS distances of all tiles of a map from one source tile, e.g. the player or the exit.
+ * The buffers are allocated from the pool once and only grow when a larger map is used,
+ * so the same flow field can be updated for every floor.
+ */
+typedef struct {
+    const memory_pool_t* pool;
+    int capacity;              // number of tiles the buffers can hold
+    int* distances;            // distance of every tile, with the same index as the hidden tiles
+    int* queue;                // the BFS queue
+    int width;                 // width of the map of the current distances
+    int height;                // height of the map of the current distances
+    vector2d_t source;         // source of the current distances
+    unsigned int tiles_version;// tiles version of the map of the current distances, 0 if there are none
+} flow_field_t;
+
+/**
+ * Creates an empty flow field, the buffers are allocated on the first update.
+ *
+ * @param pool The memory pool used for the flow field and its buffers.
+ * @return The flow field, or NULL if the allocation failed.
+ */
+flow_field_t* create_flow_field(const memory_pool_t* pool);
+
+/**
+ * Frees the flow field and its buffers.
+ *
+ * @param field The flow field to destroy.
+ */
+void destroy_flow_field(flow_field_t* field);
+
+/**
+ * Brings the distances up to date for the given map and source. The BFS over all tiles except walls
+ * only runs if the source moved or the tiles of the map changed since the last update,
+ * which is detected with the tiles version of the map.
+ *
+ * @param field The flow field.
+ * @param map The map, must neither be chunked nor packed.
+ * @param source The source tile, e.g. the player position or the exit position.
+ * @return 0 on success, 1 on failure.
+ */
+int update_flow_field(flow_field_t* field, const map_t* map, vector2d_t source);
+
+/**
+ * Returns the distance of a tile from the source of the last update in O(1).
+ *
+ * @param field The flow field.
+ * @param x The x-coordinate of the tile.
+ * @param y The y-coordinate of the tile.
+ * @return The number of steps from the source, or FLOW_UNREACHABLE for walls, unreachable
+ *         and out of bounds tiles.
+ */
+int get_flow_distance(const flow_field_t* field, int x, int y);
+
+/**
+ * Returns the step from a tile towards the source of the last update, following the flow field.
+ * Useful to let enemies pursue the player.
+ *
+ * @param field The flow field.
+ * @param x The x-coordinate of the tile.
+ * @param y The y-coordinate of the tile.
+ * @return One of the `directions`, or {0, 0} if the tile is the source or can't reach it.
+ */
+vector2d_t get_flow_direction(const flow_field_t* field, int x, int y);
+
+#endif//MAP_FLOW_FIELD_H
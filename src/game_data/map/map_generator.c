@@ -1,9 +1,16 @@
 #include "../../game_data/map/map_generator.h"
 
 #include "../../logger/logger.h"
+#include "map_bitboard.h"
+#include "map_cave_generator.h"
+#include "map_chunks.h"
+#include "map_connectivity.h"
 #include "map_populator.h"
+#include "map_random.h"
+#include "map_revealer.h"
+#include "map_room_generator.h"
 
-#include <stdlib.h>
+#include <string.h>
 
 #define TOP 0
 #define BOTTOM 1
@@ -13,16 +20,54 @@
 #define STANDARD_MAP_HEIGHT 19
 #define STANDARD_MAP_WIDTH 39
 
+#define MAX_GENERATION_ATTEMPTS 8// layouts with unreachable tiles are generated again, up to this many times
+
 /**
- * Initializes the game map by setting all tiles to a specified initial state
- * and resetting the visited array. Updates the map's hidden and revealed tile configurations.
+ * Initializes the game map by setting all tiles to a specified initial state.
+ * Updates the map's hidden and revealed tile configurations.
  *
  * @param map A constant pointer to the map structure containing dimensions and tile data
  * for the map to be initialized.
- * @param visited An array representing the visited state of each tile, which will be
- * reset during initialization. Its size should match the total number of tiles in the map.
  */
-void init_maps(const map_t* map, int* visited);
+void init_maps(const map_t* map);
+
+/**
+ * Runs a single attempt of `generate_map_tiles_with`: carves the layout, places the exit and populates the map.
+ *
+ * @param map_to_generate Pointer to the map with normalized dimensions and allocated tiles.
+ * @param generate_exit Non-zero if an exit should be generated.
+ * @param generator The generator carving the layout.
+ * @return 0 on success, non-zero on failure.
+ */
+int generate_layout(map_t* map_to_generate, int generate_exit, const map_generator_t* generator);
+
+/**
+ * Carves a maze with a random depth-first search starting at the player position
+ * and adds a few loops to it.
+ *
+ * @param map The map to carve, all tiles must be walls.
+ */
+void carve_maze(map_t* map);
+
+/**
+ * Places the exit door on a random odd position of an edge other than the start edge, that
+ * leads to a floor tile. When no such position exists, a corridor to the entry is carved.
+ *
+ * @param map The carved map.
+ * @param start_edge The edge of the start door.
+ */
+void place_exit(map_t* map, int start_edge);
+
+/**
+ * Calculates the position on the given edge and the floor position right inside of it.
+ *
+ * @param map The map.
+ * @param edge The edge (TOP, BOTTOM, LEFT or RIGHT).
+ * @param i The position along the edge.
+ * @param door Receives the position on the edge.
+ * @param inner Receives the position next to the edge inside the map.
+ */
+void get_edge_position(const map_t* map, int edge, int i, vector2d_t* door, vector2d_t* inner);
 
 /**
  * Initializes the starting position of the player and designates an entry point
@@ -67,10 +112,78 @@ void shuffle(vector2d_t* dir, int n);
  */
 int is_in_bounds(int x, int y, const map_t* map);
 
+const map_generator_t map_generators[MAX_GENERATOR_TYPES] = {
+        [MAZE_GENERATOR] = {"maze", carve_maze},
+        [ROOM_GENERATOR] = {"rooms", carve_rooms},
+        [CAVE_GENERATOR] = {"caves", carve_cave}};
+
+int add_map_loops(map_tile_t* tiles, const int width, const int height, const int num_loops) {
+    //the storage of the bitboards and the candidate list lives on the stack, so no pool allocation is needed
+    uint64_t open_bits[BITBOARD_SIZE(width, height)];
+    uint64_t candidate_bits[BITBOARD_SIZE(width, height)];
+    bitboard_t open;
+    bitboard_t candidates;
+    init_bitboard(&open, open_bits, width, height);
+    init_bitboard(&candidates, candidate_bits, width, height);
+
+    //classify all walls of the map at once
+    fill_open_bitboard(&open, tiles);
+    find_loop_candidates_bitboard(&open, &candidates);
+
+    const int candidate_count = count_bitboard(&candidates);
+    if (candidate_count == 0) return 0;
+
+    vector2d_t list[candidate_count];
+    int remaining = bitboard_to_list(&candidates, list, candidate_count);
+
+    int count = 0;
+    while (count < num_loops && remaining > 0) {
+        //draw a random candidate without replacement
+        const int pick = map_rand() % remaining;
+        const vector2d_t wall = list[pick];
+        list[pick] = list[--remaining];
+
+        //a knocked down neighbor can invalidate a candidate, so it's checked against the current state
+        if (!is_loop_candidate(&open, wall.dx, wall.dy)) continue;
+
+        tiles[wall.dx * height + wall.dy] = FLOOR;
+        set_bitboard_bit(&open, wall.dx, wall.dy, 1);
+        count++;
+    }
+    return count;
+}
+
 int generate_map(const memory_pool_t* pool, map_t* map_to_generate, const int generate_exit) {
     RETURN_WHEN_NULL(pool, 1, "Map Generator", "Memory pool is NULL");
     RETURN_WHEN_NULL(map_to_generate, 1, "Map Generator", "Map to generate is NULL");
 
+    map_to_generate->packed_tiles = NULL;
+    map_to_generate->packed_size = 0;
+    map_to_generate->batch_owned = 0;
+    forget_lit_origins(map_to_generate);
+    reset_reveal_events(map_to_generate);
+    touch_map_tiles(map_to_generate);
+    if (map_uses_chunks(map_to_generate->width, map_to_generate->height)) {
+        // large maps are not generated at once, but chunk by chunk when the player gets close
+        return init_chunked_map(pool, map_to_generate, generate_exit);
+    }
+    map_to_generate->chunks = NULL;
+
+    normalize_map_dimensions(map_to_generate);
+    //get the dimensions of the map for easier access
+    const int width = map_to_generate->width;
+    const int height = map_to_generate->height;
+
+    //allocates memory for the maps
+    map_to_generate->hidden_tiles = (map_tile_t*) memory_pool_alloc(pool, height * width * sizeof(map_tile_t));
+    RETURN_WHEN_NULL(map_to_generate->hidden_tiles, 1, "Map Generator", "Failed to allocate memory for hidden tiles");
+    map_to_generate->revealed_mask = (uint64_t*) memory_pool_alloc(pool, MASK_WORDS(height * width) * sizeof(uint64_t));
+    RETURN_WHEN_NULL(map_to_generate->revealed_mask, 1, "Map Generator", "Failed to allocate memory for the revealed mask");
+
+    return generate_map_tiles(map_to_generate, generate_exit);
+}
+
+void normalize_map_dimensions(map_t* map_to_generate) {
     //check the size of the map
     if (map_to_generate->height <= 11 || map_to_generate->width <= 11) {
         log_msg(WARNING, "Map Generator", "Defined map dimensions are too small, using default dimensions");
@@ -81,19 +194,39 @@ int generate_map(const memory_pool_t* pool, map_t* map_to_generate, const int ge
         map_to_generate->height += 1;
         map_to_generate->width += 1;
     }
-    //get the dimensions of the map for easier access
-    const int width = map_to_generate->width;
-    const int height = map_to_generate->height;
+}
 
-    //allocates memory for the maps
-    map_to_generate->hidden_tiles = (map_tile_t*) memory_pool_alloc(pool, height * width * sizeof(map_tile_t));
-    RETURN_WHEN_NULL(map_to_generate->hidden_tiles, 1, "Map Generator", "Failed to allocate memory for hidden tiles");
-    map_to_generate->revealed_tiles = (map_tile_t*) memory_pool_alloc(pool, height * width * sizeof(map_tile_t));
-    RETURN_WHEN_NULL(map_to_generate->revealed_tiles, 1, "Map Generator", "Failed to allocate memory for revealed tiles");
+int generate_map_tiles(map_t* map_to_generate, const int generate_exit) {
+    RETURN_WHEN_NULL(map_to_generate, 1, "Map Generator", "Map to generate is NULL");
+    return generate_map_tiles_with(map_to_generate, generate_exit, select_map_generator(map_to_generate->floor_nr));
+}
 
-    //initialize visited map copy for the dfs
-    int visited[width * height];
-    init_maps(map_to_generate, visited);
+int generate_map_tiles_with(map_t* map_to_generate, const int generate_exit, const generator_type_t type) {
+    RETURN_WHEN_NULL(map_to_generate, 1, "Map Generator", "Map to generate is NULL");
+    RETURN_WHEN_NULL(map_to_generate->hidden_tiles, 1, "Map Generator", "Hidden tiles are not allocated");
+    RETURN_WHEN_NULL(map_to_generate->revealed_mask, 1, "Map Generator", "Revealed mask is not allocated");
+    const map_generator_t* generator = get_map_generator(type);
+    RETURN_WHEN_NULL(generator, 1, "Map Generator", "Invalid generator type %d", type);
+
+    for (int attempt = 1; attempt <= MAX_GENERATION_ATTEMPTS; attempt++) {
+        RETURN_WHEN_TRUE(generate_layout(map_to_generate, generate_exit, generator), 1, "Map Generator",
+                         "Failed to generate the layout of floor %d", map_to_generate->floor_nr);
+
+        //entry, key and exit must be reachable, the random state differs on the next attempt
+        const int unreachable = count_unreachable_tiles(map_to_generate);
+        if (unreachable == 0) {
+            touch_map_tiles(map_to_generate);
+            return 0;
+        }
+        log_msg(WARNING, "Map Generator", "Attempt %d of the %s generator left %d tiles unreachable", attempt,
+                generator->name, unreachable);
+    }
+    log_msg(ERROR, "Map Generator", "Failed to generate a connected floor %d", map_to_generate->floor_nr);
+    return 1;
+}
+
+int generate_layout(map_t* map_to_generate, const int generate_exit, const map_generator_t* generator) {
+    init_maps(map_to_generate);
 
     const int start_edge = init_start_position(map_to_generate);
     RETURN_WHEN_TRUE(start_edge == -1, 1, "Map Generator", "Failed to initialize start position");
@@ -109,188 +242,129 @@ int generate_map(const memory_pool_t* pool, map_t* map_to_generate, const int ge
 
     map_to_generate->exit_unlocked = 0;
 
-    //get the start position
-    const int start_x = map_to_generate->player_pos.dx;
-    const int start_y = map_to_generate->player_pos.dy;
-
-    // //prepare the stack for the dfs
-    // vector2d_t stack[width * height];
-    // int top = 0;
-
-    // //add start condition
-    // stack[top++] = (vector2d_t) {start_x, start_y};
-    // visited[start_x][start_y] = 1;
-    // map_to_generate->hidden_tiles[start_x * height + start_y] = FLOOR;
-
-    carve_passage(start_x, start_y, map_to_generate, visited);
-
-    // for (int i = 0; i < height; i++) {
-    //     char line_buffer1[width + 1];
-    //     char line_buffer2[width + 1];
-    //     for (int j = 0; j < width; j++) {
-    //         line_buffer1[j] = map_to_generate->hidden_tiles[j * height + i] == WALL ? '#' : ' ';
-    //         line_buffer2[j] = visited[j * height + i] == 1 ? '#' : ' ';
-    //     }
-    //     line_buffer1[width] = '\0';
-    //     line_buffer2[width] = '\0';
-    //     usleep(100);
-    //     DEBUG_LOG("Special", "%s | %s", line_buffer1, line_buffer2);
-    // }
-
-    // //dfs loop
-    // while (top > 0) {
-    //     const vector2d_t current = stack[top - 1];
-    //     const int x = current.dx;
-    //     const int y = current.dy;
-    //
-    //     vector2d_t shuffled_dirs[4];
-    //     for (int i = 0; i < 4; i++) {
-    //         shuffled_dirs[i] = directions[i];
-    //     }
-    //     shuffle(shuffled_dirs, 4);
-    //
-    //     int found = 0;
-    //
-    //     for (int i = 0; i < 4; i++) {
-    //         const int nx = x + shuffled_dirs[i].dx * 2;
-    //         const int ny = y + shuffled_dirs[i].dy * 2;
-    //
-    //         const bool is_in_bounds = nx >= 0 && nx < width && ny >= 0 && ny < height;
-    //         const bool is_valid_cell = is_in_bounds && !visited[nx][ny];
-    //         if (is_valid_cell) {
-    //             const int wall_x = x + shuffled_dirs[i].dx;
-    //             const int wall_y = y + shuffled_dirs[i].dy;
-    //
-    //             map_to_generate->hidden_tiles[wall_x * height + wall_y] = FLOOR;
-    //             map_to_generate->hidden_tiles[nx * height + ny] = FLOOR;
-    //             visited[nx][ny] = 1;
-    //
-    //             stack[top++] = (vector2d_t) {nx, ny};
-    //             found = 1;
-    //             break;
-    //         }
-    //     }
-    //
-    //     if (!found) {
-    //         top--;// backtracking
-    //     }
-    // }
-
-    const int num_loops = (width * height) / 100 + 1;
+    //the generator only carves the layout, entry, exit and population are the same for all of them
+    generator->carve(map_to_generate);
+    map_to_generate->hidden_tiles[map_to_generate->entry_pos.dx * map_to_generate->height + map_to_generate->entry_pos.dy] = FLOOR;
 
-    int count = 0;
-    int max_attempts = num_loops * 10;
+    if (generate_exit) {// only generate an exit, when told so!
+        place_exit(map_to_generate, start_edge);
+    } else {
+        map_to_generate->exit_pos.dx = -1;
+        map_to_generate->exit_pos.dy = -1;
+    }
+
+    RETURN_WHEN_TRUE(populate_map(map_to_generate), 1, "Map Generator", "Failed to populate map");
+    return 0;
+}
+
+const map_generator_t* get_map_generator(const generator_type_t type) {
+    if (type < 0 || type >= MAX_GENERATOR_TYPES) return NULL;
+    return &map_generators[type];
+}
+
+generator_type_t select_map_generator(const int floor_nr) {
+    // floors are counted from 1, the first floor is always a maze, afterward the layouts take turns
+    if (floor_nr <= 1) return MAZE_GENERATOR;
+    return (generator_type_t) ((floor_nr - 1) % MAX_GENERATOR_TYPES);
+}
+
+void carve_corridor(const map_t* map, const vector2d_t from, const vector2d_t to) {
+    const int step_x = to.dx > from.dx ? 1 : -1;
+    const int step_y = to.dy > from.dy ? 1 : -1;
+
+    //first walk horizontally, then vertically
+    for (int x = from.dx; x != to.dx; x += step_x) {
+        map->hidden_tiles[x * map->height + from.dy] = FLOOR;
+    }
+    for (int y = from.dy; y != to.dy; y += step_y) {
+        map->hidden_tiles[to.dx * map->height + y] = FLOOR;
+    }
+    map->hidden_tiles[to.dx * map->height + to.dy] = FLOOR;
+}
+
+void carve_maze(map_t* map) {
+    //initialize visited map copy for the dfs
+    int visited[map->width * map->height];
+    for (int i = 0; i < map->width * map->height; i++) {
+        visited[i] = 0;
+    }
+    carve_passage(map->player_pos.dx, map->player_pos.dy, map, visited);
 
     //add loops to the map
-    while (count < num_loops && max_attempts > 0) {
-        // Pick a random cell
-        const int x = 1 + rand() % (width - 2);
-        const int y = 1 + rand() % (height - 2);
-
-        // If the wall has exactly 2 opposing floor neighbors, knock it down to create a loop
-        if (map_to_generate->hidden_tiles[x * height + y] == WALL) {
-            int neighbor_directions[4] = {0, 0, 0, 0};
-
-            int floor_count = 0;
-            for (int i = 0; i < 4; i++) {
-                const int dx = x + directions[i].dx;
-                const int dy = y + directions[i].dy;
-
-                if (map_to_generate->hidden_tiles[dx * height + dy] == FLOOR) {
-                    floor_count++;
-                    neighbor_directions[i] = 1;
-                }
-            }
+    add_map_loops(map->hidden_tiles, map->width, map->height, (map->width * map->height) / 100 + 1);
+}
 
-            // check if the wall has exactly 2 opposing floor neighbors
-            if ((floor_count == 2) &&
-                ((neighbor_directions[TOP] && neighbor_directions[BOTTOM]) ||
-                 (neighbor_directions[LEFT] && neighbor_directions[RIGHT]))) {
-                map_to_generate->hidden_tiles[x * height + y] = FLOOR;
+void place_exit(map_t* map, const int start_edge) {
+    const int width = map->width;
+    const int height = map->height;
+
+    //collect every odd position on the other edges, that leads to a floor
+    vector2d_t doors[width + height];
+    vector2d_t inner[width + height];
+    int count = 0;
+    for (int edge = 0; edge < 4; edge++) {
+        if (edge == start_edge) continue;
+        const int length = edge == TOP || edge == BOTTOM ? width : height;
+        for (int i = 1; i < length - 1; i += 2) {
+            vector2d_t door;
+            vector2d_t in;
+            get_edge_position(map, edge, i, &door, &in);
+            if (map->hidden_tiles[in.dx * height + in.dy] == FLOOR) {
+                doors[count] = door;
+                inner[count] = in;
                 count++;
             }
         }
-
-        max_attempts--;
     }
 
-    if (generate_exit) {// only generate an exit, when told so!
-        int exit_x = 0;
-        int exit_y = 0;
-        // get a random exit edge that is different from the start edge
+    vector2d_t door;
+    vector2d_t in;
+    if (count > 0) {
+        const int pick = map_rand() % count;
+        door = doors[pick];
+        in = inner[pick];
+    } else {
+        //no floor touches the other edges, so a corridor to the entry is dug
         int exit_edge = start_edge;
         while (exit_edge == start_edge) {
-            exit_edge = rand() % 4;
+            exit_edge = map_rand() % 4;
         }
-
-        bool valid_exit = false;
-        do {
-            switch (exit_edge) {
-                case TOP:
-                    exit_x = 1 + 2 * (rand() % ((width - 2) / 2));
-                    exit_y = 0;
-                    valid_exit = map_to_generate->hidden_tiles[exit_x * height + exit_y + 1] == FLOOR;
-                    break;
-                case BOTTOM:
-                    exit_x = 1 + 2 * (rand() % ((width - 2) / 2));
-                    exit_y = height - 1;
-                    valid_exit = map_to_generate->hidden_tiles[exit_x * height + exit_y - 1] == FLOOR;
-                    break;
-                case LEFT:
-                    exit_x = 0;
-                    exit_y = 1 + 2 * (rand() % ((height - 2) / 2));
-                    valid_exit = map_to_generate->hidden_tiles[(exit_x + 1) * height + exit_y] == FLOOR;
-                    break;
-                case RIGHT:
-                    exit_x = width - 1;
-                    exit_y = 1 + 2 * (rand() % ((height - 2) / 2));
-                    valid_exit = map_to_generate->hidden_tiles[(exit_x - 1) * height + exit_y] == FLOOR;
-                    break;
-                default:
-                    log_msg(ERROR, "Map Generator", "Invalid exit edge");
-                    return 1;
-            }
-        } while (!valid_exit);
-
-        map_to_generate->hidden_tiles[exit_x * height + exit_y] = EXIT_DOOR;
-
-        switch (exit_edge) {
-            case TOP:
-                map_to_generate->exit_pos.dx = exit_x;
-                map_to_generate->exit_pos.dy = 1;
-                break;
-            case BOTTOM:
-                map_to_generate->exit_pos.dx = exit_x;
-                map_to_generate->exit_pos.dy = height - 2;
-                break;
-            case LEFT:
-                map_to_generate->exit_pos.dx = 1;
-                map_to_generate->exit_pos.dy = exit_y;
-                break;
-            case RIGHT:
-                map_to_generate->exit_pos.dx = width - 2;
-                map_to_generate->exit_pos.dy = exit_y;
-                break;
-            default:;
-        }
-
-    } else {
-        map_to_generate->exit_pos.dx = -1;
-        map_to_generate->exit_pos.dy = -1;
+        const int length = exit_edge == TOP || exit_edge == BOTTOM ? width : height;
+        get_edge_position(map, exit_edge, 1 + 2 * (map_rand() % ((length - 2) / 2)), &door, &in);
+        carve_corridor(map, in, map->entry_pos);
     }
 
-    RETURN_WHEN_TRUE(populate_map(map_to_generate), 1, "Map Generator", "Failed to populate map");
+    map->hidden_tiles[door.dx * height + door.dy] = EXIT_DOOR;
+    map->exit_pos = in;
+}
 
-    return 0;
+void get_edge_position(const map_t* map, const int edge, const int i, vector2d_t* door, vector2d_t* inner) {
+    switch (edge) {
+        case TOP:
+            *door = (vector2d_t) {i, 0};
+            *inner = (vector2d_t) {i, 1};
+            break;
+        case BOTTOM:
+            *door = (vector2d_t) {i, map->height - 1};
+            *inner = (vector2d_t) {i, map->height - 2};
+            break;
+        case LEFT:
+            *door = (vector2d_t) {0, i};
+            *inner = (vector2d_t) {1, i};
+            break;
+        default:
+            *door = (vector2d_t) {map->width - 1, i};
+            *inner = (vector2d_t) {map->width - 2, i};
+            break;
+    }
 }
 
-void init_maps(const map_t* map, int* visited) {
-    //iterate through each tile and set it to WALL / HIDDEN / 0
+void init_maps(const map_t* map) {
+    //iterate through each tile and set it to WALL, nothing is revealed yet
     for (int i = 0; i < map->width * map->height; i++) {
         map->hidden_tiles[i] = WALL;
-        map->revealed_tiles[i] = HIDDEN;
-        visited[i] = 0;
     }
+    memset(map->revealed_mask, 0, MASK_WORDS(map->width * map->height) * sizeof(uint64_t));
 }
 
 int init_start_position(map_t* map) {
@@ -298,28 +372,28 @@ int init_start_position(map_t* map) {
     const int height = map->height;
 
     //get random start edge
-    const int start_edge = rand() % 4;
+    const int start_edge = map_rand() % 4;
 
     //set the start position
     switch (start_edge) {
         case TOP:
-            map->player_pos.dx = 3 + 2 * (rand() % ((width - 5) / 2));
+            map->player_pos.dx = 3 + 2 * (map_rand() % ((width - 5) / 2));
             map->player_pos.dy = 1;
             map->hidden_tiles[map->player_pos.dx * height + 0] = START_DOOR;
             break;
         case BOTTOM:
-            map->player_pos.dx = 3 + 2 * (rand() % ((width - 5) / 2));
+            map->player_pos.dx = 3 + 2 * (map_rand() % ((width - 5) / 2));
             map->player_pos.dy = height - 2;
             map->hidden_tiles[map->player_pos.dx * height + (height - 1)] = START_DOOR;
             break;
         case LEFT:
             map->player_pos.dx = 1;
-            map->player_pos.dy = 3 + 2 * (rand() % ((height - 5) / 2));
+            map->player_pos.dy = 3 + 2 * (map_rand() % ((height - 5) / 2));
             map->hidden_tiles[0 * height + map->player_pos.dy] = START_DOOR;
             break;
         case RIGHT:
             map->player_pos.dx = width - 2;
-            map->player_pos.dy = 3 + 2 * (rand() % ((height - 5) / 2));
+            map->player_pos.dy = 3 + 2 * (map_rand() % ((height - 5) / 2));
             map->hidden_tiles[(width - 1) * height + map->player_pos.dy] = START_DOOR;
             break;
         default:
@@ -362,7 +436,7 @@ void carve_passage(const int x, const int y, map_t* map, int* visited) {
 
 void shuffle(vector2d_t* dir, const int n) {
     for (int i = n - 1; i > 0; i--) {
-        const int j = rand() % (i + 1);
+        const int j = map_rand() % (i + 1);
         vector2d_t tmp = dir[j];
         dir[j] = dir[i];
         dir[i] = tmp;
@@ -4,6 +4,29 @@
 #include "../../memory/mem_mgmt.h"
 #include "map.h"
 
+typedef enum {
+    MAZE_GENERATOR,
+    ROOM_GENERATOR,
+    CAVE_GENERATOR,
+    MAX_GENERATOR_TYPES
+} generator_type_t;
+
+/**
+ * A layout algorithm of a floor. The generator only carves the floor tiles, the start door,
+ * the exit door, the key, the fountains and the enemies are placed the same way for all generators.
+ */
+typedef struct {
+    const char* name;
+    /**
+     * Carves the layout into the hidden tiles of the map. When called, all tiles are walls, the start door
+     * is set and the entry position lies next to it. Afterward, every floor tile must be reachable from
+     * the entry position.
+     *
+     * @param map The map to carve.
+     */
+    void (*carve)(map_t* map);
+} map_generator_t;
+
 /**
  * Generates a map using a specified memory pool and configuration.
  *
@@ -16,4 +39,69 @@
  */
 int generate_map(const memory_pool_t* pool, map_t* map_to_generate, int generate_exit);
 
+/**
+ * Corrects the dimensions of the given map to the requirements of the maze generation.
+ * Too small maps get the standard dimensions, even dimensions are increased by one.
+ *
+ * @param map_to_generate Pointer to the map whose width and height are corrected.
+ */
+void normalize_map_dimensions(map_t* map_to_generate);
+
+/**
+ * Generates the maze, the entry, the exit and populates the map, without any memory allocation.
+ * The hidden and revealed tiles must already point to width * height tiles each,
+ * so the function can be used on preallocated maps and from worker threads.
+ *
+ * @param map_to_generate Pointer to the map with normalized dimensions and allocated tiles.
+ * @param generate_exit Non-zero if an exit should be generated.
+ * @return 0 on success, non-zero on failure.
+ */
+int generate_map_tiles(map_t* map_to_generate, int generate_exit);
+
+/**
+ * Same as `generate_map_tiles`, but with an explicitly chosen generator instead of the one of the floor.
+ *
+ * @param map_to_generate Pointer to the map with normalized dimensions and allocated tiles.
+ * @param generate_exit Non-zero if an exit should be generated.
+ * @param type The generator carving the layout.
+ * @return 0 on success, non-zero on failure.
+ */
+int generate_map_tiles_with(map_t* map_to_generate, int generate_exit, generator_type_t type);
+
+/**
+ * @param type The generator type.
+ * @return The generator of the given type, or NULL if the type is invalid.
+ */
+const map_generator_t* get_map_generator(generator_type_t type);
+
+/**
+ * Selects the generator for a floor. The first floor is a maze, the following floors take turns.
+ *
+ * @param floor_nr The number of the floor.
+ * @return The generator type of the floor.
+ */
+generator_type_t select_map_generator(int floor_nr);
+
+/**
+ * Carves an L-shaped corridor, first horizontally from `from`, then vertically to `to`.
+ * Both positions must lie inside the outer walls.
+ *
+ * @param map The map to carve.
+ * @param from The start of the corridor.
+ * @param to The end of the corridor.
+ */
+void carve_corridor(const map_t* map, vector2d_t from, vector2d_t to);
+
+/**
+ * Knocks down walls between two opposing floor tiles to add loops to a maze. All walls are classified
+ * at once on a bitboard and the loops are drawn from the resulting candidate list.
+ *
+ * @param tiles The column major tiles of the maze.
+ * @param width The width of the maze.
+ * @param height The height of the maze.
+ * @param num_loops The number of loops to add.
+ * @return The number of added loops, smaller than `num_loops` if the candidates ran out.
+ */
+int add_map_loops(map_tile_t* tiles, int width, int height, int num_loops);
+
 #endif//MAP_GENERATOR_H
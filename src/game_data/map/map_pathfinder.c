@@ -0,0 +1,334 @@
+#include "map_pathfinder.h"
+
+#include "../../logger/logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// the heap prefers the lower estimate and on ties the tile closer to the goal, i.e. with the higher cost
+#define HEAP_LESS(pathfinder, a, b) \
+    ((pathfinder)->estimate[a] < (pathfinder)->estimate[b] || \
+     ((pathfinder)->estimate[a] == (pathfinder)->estimate[b] && (pathfinder)->cost[a] > (pathfinder)->cost[b]))
+
+/**
+ * Makes sure the node arrays can hold the given number of tiles, growing them if needed.
+ *
+ * @param pathfinder The pathfinder.
+ * @param tile_count The number of tiles.
+ * @return 0 on success, 1 if the allocation failed.
+ */
+int reserve_pathfinder(pathfinder_t* pathfinder, int tile_count);
+
+/**
+ * Frees the node arrays of the pathfinder.
+ *
+ * @param pathfinder The pathfinder.
+ */
+void free_pathfinder_nodes(pathfinder_t* pathfinder);
+
+/**
+ * Looks up a cached path that leads from the start to the goal, either starting there or passing through it.
+ *
+ * @param pathfinder The pathfinder.
+ * @param map The map of the query.
+ * @param start The start tile.
+ * @param goal The goal tile.
+ * @param known_only If non-zero, only paths over revealed tiles are used.
+ * @param steps Set to the remaining steps of the cached path.
+ * @return The number of remaining steps, or -1 if no cached path matches.
+ */
+int lookup_cached_path(const pathfinder_t* pathfinder, const map_t* map, vector2d_t start, vector2d_t goal,
+                       int known_only, const vector2d_t** steps);
+
+/**
+ * Runs A* from the start to the goal and stores the path in the next cache slot.
+ *
+ * @param pathfinder The pathfinder, with node arrays large enough for the map.
+ * @param map The map.
+ * @param start The start tile.
+ * @param goal The goal tile.
+ * @param known_only If non-zero, only revealed tiles are crossed.
+ * @return The cache entry holding the path, or NULL if there is no path or the allocation failed.
+ */
+path_cache_entry_t* search_path(pathfinder_t* pathfinder, const map_t* map, vector2d_t start, vector2d_t goal,
+                                int known_only);
+
+/**
+ * Adds a tile to the heap.
+ *
+ * @param pathfinder The pathfinder.
+ * @param heap_size The number of tiles in the heap, incremented by one.
+ * @param index The index of the tile, its estimate must be set.
+ */
+void heap_push(pathfinder_t* pathfinder, int* heap_size, int index);
+
+/**
+ * Removes the tile with the lowest estimate from the heap and marks it as closed.
+ *
+ * @param pathfinder The pathfinder.
+ * @param heap_size The number of tiles in the heap, must be positive and is decremented by one.
+ * @return The index of the removed tile.
+ */
+int heap_pop(pathfinder_t* pathfinder, int* heap_size);
+
+/**
+ * Moves a tile towards the top of the heap after its estimate decreased.
+ *
+ * @param pathfinder The pathfinder.
+ * @param position The position of the tile in the heap.
+ */
+void heap_sift_up(const pathfinder_t* pathfinder, int position);
+
+pathfinder_t* create_pathfinder(const memory_pool_t* pool) {
+    RETURN_WHEN_NULL(pool, NULL, "Pathfinder", "Memory pool is NULL");
+
+    pathfinder_t* pathfinder = memory_pool_alloc(pool, sizeof(pathfinder_t));
+    RETURN_WHEN_NULL(pathfinder, NULL, "Pathfinder", "Failed to allocate memory for the pathfinder");
+    memset(pathfinder, 0, sizeof(pathfinder_t));
+    pathfinder->pool = pool;
+    return pathfinder;
+}
+
+void destroy_pathfinder(pathfinder_t* pathfinder) {
+    RETURN_WHEN_NULL(pathfinder, , "Pathfinder", "In `destroy_pathfinder` given pathfinder is NULL")
+    free_pathfinder_nodes(pathfinder);
+    for (int i = 0; i < PATH_CACHE_SLOTS; i++) {
+        if (pathfinder->cache[i].steps != NULL) memory_pool_free(pathfinder->pool, pathfinder->cache[i].steps);
+    }
+    memory_pool_free(pathfinder->pool, pathfinder);
+}
+
+int find_path(pathfinder_t* pathfinder, const map_t* map, const vector2d_t start, const vector2d_t goal,
+              const int known_only, const vector2d_t** steps) {
+    RETURN_WHEN_NULL(pathfinder, -1, "Pathfinder", "Pathfinder is NULL");
+    RETURN_WHEN_NULL(map, -1, "Pathfinder", "Map is NULL");
+    RETURN_WHEN_NULL(steps, -1, "Pathfinder", "Steps are NULL");
+    RETURN_WHEN_TRUE(map->chunks != NULL || map->hidden_tiles == NULL, -1, "Pathfinder",
+                     "Map %d must neither be chunked nor packed", map->floor_nr);
+    RETURN_WHEN_TRUE(start.dx < 0 || start.dx >= map->width || start.dy < 0 || start.dy >= map->height ||
+                             goal.dx < 0 || goal.dx >= map->width || goal.dy < 0 || goal.dy >= map->height,
+                     -1, "Pathfinder", "Start or goal is out of bounds");
+
+    const int cached = lookup_cached_path(pathfinder, map, start, goal, known_only, steps);
+    if (cached != -1) return cached;
+
+    RETURN_WHEN_TRUE(reserve_pathfinder(pathfinder, map->width * map->height) != 0, -1, "Pathfinder",
+                     "Failed to allocate the node arrays for map %d", map->floor_nr);
+    const path_cache_entry_t* entry = search_path(pathfinder, map, start, goal, known_only);
+    if (entry == NULL) return -1;
+
+    *steps = entry->steps;
+    return entry->length;
+}
+
+int find_exit_step(pathfinder_t* pathfinder, const map_t* map, vector2d_t* step) {
+    RETURN_WHEN_NULL(map, 0, "Pathfinder", "Map is NULL");
+    RETURN_WHEN_NULL(step, 0, "Pathfinder", "Step is NULL");
+
+    //the exit position is the floor inside the map, the door lies next to it on the outer border
+    for (int i = 0; i < 4; i++) {
+        const vector2d_t door = {map->exit_pos.dx + directions[i].dx, map->exit_pos.dy + directions[i].dy};
+        if (get_revealed_tile(map, door.dx, door.dy) != EXIT_DOOR) continue;
+
+        const vector2d_t* steps;
+        if (find_path(pathfinder, map, map->player_pos, door, 1, &steps) <= 0) return 0;
+        *step = steps[0];
+        return 1;
+    }
+    return 0;
+}
+
+int reserve_pathfinder(pathfinder_t* pathfinder, const int tile_count) {
+    if (tile_count <= pathfinder->capacity) return 0;
+
+    free_pathfinder_nodes(pathfinder);
+    const memory_pool_t* pool = pathfinder->pool;
+    pathfinder->seen = memory_pool_alloc(pool, tile_count * sizeof(unsigned int));
+    pathfinder->cost = memory_pool_alloc(pool, tile_count * sizeof(int));
+    pathfinder->estimate = memory_pool_alloc(pool, tile_count * sizeof(int));
+    pathfinder->parent = memory_pool_alloc(pool, tile_count * sizeof(int));
+    pathfinder->heap_index = memory_pool_alloc(pool, tile_count * sizeof(int));
+    pathfinder->heap = memory_pool_alloc(pool, tile_count * sizeof(int));
+    if (pathfinder->seen == NULL || pathfinder->cost == NULL || pathfinder->estimate == NULL ||
+        pathfinder->parent == NULL || pathfinder->heap_index == NULL || pathfinder->heap == NULL) {
+        free_pathfinder_nodes(pathfinder);
+        return 1;
+    }
+    memset(pathfinder->seen, 0, tile_count * sizeof(unsigned int));
+    pathfinder->query = 0;
+    pathfinder->capacity = tile_count;
+    return 0;
+}
+
+void free_pathfinder_nodes(pathfinder_t* pathfinder) {
+    int** arrays[] = {&pathfinder->cost, &pathfinder->estimate, &pathfinder->parent,
+                      &pathfinder->heap_index, &pathfinder->heap};
+    for (int i = 0; i < 5; i++) {
+        if (*arrays[i] != NULL) memory_pool_free(pathfinder->pool, *arrays[i]);
+        *arrays[i] = NULL;
+    }
+    if (pathfinder->seen != NULL) memory_pool_free(pathfinder->pool, pathfinder->seen);
+    pathfinder->seen = NULL;
+    pathfinder->capacity = 0;
+}
+
+int lookup_cached_path(const pathfinder_t* pathfinder, const map_t* map, const vector2d_t start,
+                       const vector2d_t goal, const int known_only, const vector2d_t** steps) {
+    for (int i = 0; i < PATH_CACHE_SLOTS; i++) {
+        const path_cache_entry_t* entry = &pathfinder->cache[i];
+        if (entry->tiles_version != map->tiles_version || entry->known_only != known_only ||
+            entry->goal.dx != goal.dx || entry->goal.dy != goal.dy) {
+            continue;
+        }
+        //revealing tiles can open a shorter known path
+        if (known_only && (entry->reveal_version != map->reveal_version ||
+                           entry->reveal_event_count != map->reveal_event_count)) {
+            continue;
+        }
+        if (entry->start.dx == start.dx && entry->start.dy == start.dy) {
+            *steps = entry->steps;
+            return entry->length;
+        }
+        //every part of a shortest path is a shortest path as well
+        for (int step = 0; step < entry->length; step++) {
+            if (entry->steps[step].dx == start.dx && entry->steps[step].dy == start.dy) {
+                *steps = entry->steps + step + 1;
+                return entry->length - step - 1;
+            }
+        }
+    }
+    return -1;
+}
+
+path_cache_entry_t* search_path(pathfinder_t* pathfinder, const map_t* map, const vector2d_t start,
+                                const vector2d_t goal, const int known_only) {
+    const int height = map->height;
+    const map_tile_t* tiles = map->hidden_tiles;
+    const uint64_t* mask = map->revealed_mask;
+    unsigned int* seen = pathfinder->seen;
+    int* cost = pathfinder->cost;
+    int* estimate = pathfinder->estimate;
+    int* parent = pathfinder->parent;
+    int* heap_index = pathfinder->heap_index;
+
+    if (++pathfinder->query == 0) {
+        //the query ids wrapped around, old marks could be mistaken for new ones
+        memset(seen, 0, pathfinder->capacity * sizeof(unsigned int));
+        pathfinder->query = 1;
+    }
+    const unsigned int query = pathfinder->query;
+
+    const int start_index = start.dx * height + start.dy;
+    const int goal_index = goal.dx * height + goal.dy;
+    if (tiles[goal_index] == WALL || (known_only && !IS_REVEALED(mask, goal_index))) return NULL;
+
+    seen[start_index] = query;
+    cost[start_index] = 0;
+    estimate[start_index] = abs(goal.dx - start.dx) + abs(goal.dy - start.dy);
+    parent[start_index] = -1;
+    int heap_size = 0;
+    heap_push(pathfinder, &heap_size, start_index);
+
+    int found = 0;
+    while (heap_size > 0) {
+        const int index = heap_pop(pathfinder, &heap_size);
+        if (index == goal_index) {
+            found = 1;
+            break;
+        }
+        const int next_cost = cost[index] + 1;
+        int neighbours[4];
+        const int neighbour_count = get_neighbour_indices(map, index, neighbours);
+        for (int i = 0; i < neighbour_count; i++) {
+            const int neighbour = neighbours[i];
+            if (tiles[neighbour] == WALL) continue;
+            if (known_only && !IS_REVEALED(mask, neighbour)) continue;
+
+            if (seen[neighbour] != query) {
+                seen[neighbour] = query;
+                cost[neighbour] = next_cost;
+                estimate[neighbour] = next_cost + abs(goal.dx - neighbour / height) + abs(goal.dy - neighbour % height);
+                parent[neighbour] = index;
+                heap_push(pathfinder, &heap_size, neighbour);
+            } else if (heap_index[neighbour] != -1 && next_cost < cost[neighbour]) {
+                //the manhattan distance is consistent, so closed tiles never get cheaper
+                estimate[neighbour] -= cost[neighbour] - next_cost;
+                cost[neighbour] = next_cost;
+                parent[neighbour] = index;
+                heap_sift_up(pathfinder, heap_index[neighbour]);
+            }
+        }
+    }
+    if (!found) return NULL;
+
+    path_cache_entry_t* entry = &pathfinder->cache[pathfinder->next_slot];
+    pathfinder->next_slot = (pathfinder->next_slot + 1) % PATH_CACHE_SLOTS;
+    const int length = cost[goal_index];
+    if (length > entry->capacity) {
+        if (entry->steps != NULL) memory_pool_free(pathfinder->pool, entry->steps);
+        entry->steps = memory_pool_alloc(pathfinder->pool, length * sizeof(vector2d_t));
+        entry->capacity = entry->steps == NULL ? 0 : length;
+        if (entry->steps == NULL) {
+            entry->tiles_version = 0;
+            log_msg(ERROR, "Pathfinder", "Failed to allocate memory for a path of %d steps", length);
+            return NULL;
+        }
+    }
+    for (int index = goal_index, step = length - 1; step >= 0; index = parent[index], step--) {
+        entry->steps[step] = (vector2d_t) {index / height, index % height};
+    }
+    entry->start = start;
+    entry->goal = goal;
+    entry->tiles_version = map->tiles_version;
+    entry->known_only = known_only;
+    entry->reveal_version = map->reveal_version;
+    entry->reveal_event_count = map->reveal_event_count;
+    entry->length = length;
+    return entry;
+}
+
+void heap_push(pathfinder_t* pathfinder, int* heap_size, const int index) {
+    const int position = (*heap_size)++;
+    pathfinder->heap[position] = index;
+    pathfinder->heap_index[index] = position;
+    heap_sift_up(pathfinder, position);
+}
+
+void heap_sift_up(const pathfinder_t* pathfinder, int position) {
+    int* heap = pathfinder->heap;
+    int* heap_index = pathfinder->heap_index;
+    const int index = heap[position];
+    while (position > 0) {
+        const int parent = (position - 1) / 2;
+        if (!HEAP_LESS(pathfinder, index, heap[parent])) break;
+        heap[position] = heap[parent];
+        heap_index[heap[position]] = position;
+        position = parent;
+    }
+    heap[position] = index;
+    heap_index[index] = position;
+}
+
+int heap_pop(pathfinder_t* pathfinder, int* heap_size) {
+    int* heap = pathfinder->heap;
+    int* heap_index = pathfinder->heap_index;
+    const int top = heap[0];
+    heap_index[top] = -1;
+
+    const int size = --(*heap_size);
+    if (size == 0) return top;
+    const int last = heap[size];
+    int position = 0;
+    while (1) {
+        int child = 2 * position + 1;
+        if (child >= size) break;
+        if (child + 1 < size && HEAP_LESS(pathfinder, heap[child + 1], heap[child])) child++;
+        if (!HEAP_LESS(pathfinder, heap[child], last)) break;
+        heap[position] = heap[child];
+        heap_index[heap[position]] = position;
+        position = child;
+    }
+    heap[position] = last;
+    heap_index[last] = position;
+    return top;
+}
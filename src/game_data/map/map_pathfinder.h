@@ -0,0 +1,87 @@
+#ifndef MAP_PATHFINDER_H
+#define MAP_PATHFINDER_H
+
+#include "../../memory/mem_mgmt.h"
+#include "map.h"
+
+#define PATH_CACHE_SLOTS 8// number of paths the pathfinder remembers
+
+/**
+ * A path remembered by the pathfinder. The steps lead from the tile after `start` up to and including `goal`.
+ */
+typedef struct {
+    vector2d_t start;
+    vector2d_t goal;
+    unsigned int tiles_version;// tiles version of the map the path was found on, 0 if the slot is empty
+    int known_only;            // non-zero if the path only crosses revealed tiles
+    unsigned int reveal_version;    // reveal version of the map the known only path was found on
+    unsigned int reveal_event_count;// reveal events of the map when the known only path was found
+    int length;                // number of steps
+    int capacity;              // number of steps the buffer can hold
+    vector2d_t* steps;
+} path_cache_entry_t;
+
+/**
+ * An A* pathfinder over the 4-connected tiles of a map. The node arrays and the binary heap are allocated from
+ * the pool and only grow when a larger map is used, so queries don't allocate. Nodes are marked with the id of
+ * the query that touched them, so the arrays never have to be cleared either.
+ */
+typedef struct {
+    const memory_pool_t* pool;
+    int capacity;              // number of tiles the node arrays can hold
+    unsigned int query;        // id of the current query
+    unsigned int* seen;        // id of the last query that reached the tile
+    int* cost;                 // steps from the start
+    int* estimate;             // steps from the start plus the manhattan distance to the goal
+    int* parent;               // index of the previous tile on the best known path
+    int* heap_index;           // position in the heap, -1 if the tile is closed
+    int* heap;                 // binary min heap of tile indices ordered by estimate
+    int next_slot;             // cache slot that is replaced next
+    path_cache_entry_t cache[PATH_CACHE_SLOTS];
+} pathfinder_t;
+
+/**
+ * Creates a pathfinder, the node arrays are allocated on the first query.
+ *
+ * @param pool The memory pool used for the pathfinder and its buffers.
+ * @return The pathfinder, or NULL if the allocation failed.
+ */
+pathfinder_t* create_pathfinder(const memory_pool_t* pool);
+
+/**
+ * Frees the pathfinder, its node arrays and all cached paths.
+ *
+ * @param pathfinder The pathfinder to destroy.
+ */
+void destroy_pathfinder(pathfinder_t* pathfinder);
+
+/**
+ * Finds a shortest path between two tiles, moving only horizontally or vertically and never through walls.
+ * Paths are cached by start, goal and tiles version of the map, known only paths also by the reveal version and
+ * the reveal events of the map (see `record_reveal_event`). A query starting on a cached path towards the same goal
+ * is answered with the rest of that path, so following a path step by step never runs A* again.
+ *
+ * @param pathfinder The pathfinder.
+ * @param map The map, must neither be chunked nor packed.
+ * @param start The start tile.
+ * @param goal The goal tile.
+ * @param known_only If non-zero, the path only crosses revealed tiles, e.g. to auto walk to a known location.
+ * @param steps Set to the steps from the tile after the start up to the goal. Stays valid until the next query.
+ * @return The number of steps, or -1 if there is no path or the inputs are invalid.
+ */
+int find_path(pathfinder_t* pathfinder, const map_t* map, vector2d_t start, vector2d_t goal, int known_only,
+              const vector2d_t** steps);
+
+/**
+ * Finds the next step of the player on a shortest path over revealed tiles to the exit door, so walking
+ * onto the door triggers the exit like a manual step would.
+ *
+ * @param pathfinder The pathfinder.
+ * @param map The map with the player position, must neither be chunked nor packed.
+ * @param step Set to the next position of the player.
+ * @return 1 if a step was found, 0 if the exit door isn't revealed, can't be reached over revealed tiles
+ *         or the player already stands on it.
+ */
+int find_exit_step(pathfinder_t* pathfinder, const map_t* map, vector2d_t* step);
+
+#endif//MAP_PATHFINDER_H
@@ -1,152 +1,175 @@
 #include "../../game_data/map/map_populator.h"
 
 #include "../../logger/logger.h"
+#include "map_bitboard.h"
+#include "map_random.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #define STANDARD_ENEMY_COUNT 5
 
 #define ENEMY_MIN_DISTANCE 3
+#define FAR_AWAY 255// distance grid value of tiles without an enemy or start door nearby
+
+typedef struct {
+    vector2d_t* cells;
+    int remaining;// the cells which haven't been drawn yet are at the front of the list
+} candidates_t;
 
 /**
  * Place a key in the map at a specific location.
  * @param map_to_populate the map structure where the key will be placed
+ * @param dead_ends the dead end candidates, the key is preferably placed in one
+ * @param floors the floor candidates, used when no dead end is left
  */
-void place_key(const map_t* map_to_populate);
+void place_key(const map_t* map_to_populate, candidates_t* dead_ends, candidates_t* floors);
 
 /**
- * Place enemies randomly on the map based on the enemy count.
+ * Place enemies randomly on the map based on the enemy count. A distance grid tracks how close each
+ * tile is to an enemy or a start door, so the minimum distance is checked with a single lookup.
+ * If there are not enough candidates left, the enemy count is reduced to the placed enemies.
  * @param map_to_populate the map structure where enemies will be placed
+ * @param floors the floor candidates
  */
-void place_enemy(map_t* map_to_populate);
+void place_enemy(map_t* map_to_populate, candidates_t* floors);
 
 /**
  * Place a fountain in the map at specific locations.
  * @param map_to_populate the map structure where the fountain(s) will be placed
+ * @param dead_ends the dead end candidates, the fountains are preferably placed in them
+ * @param floors the floor candidates, used when no dead end is left
  */
-void place_fountain(const map_t* map_to_populate);
-
-/**
- * Check if a cell is a dead end (only one neighbor)
- * @param x x coordinate of the cell
- * @param y y coordinate of the cell
- * @param map_to_check the map to check
- * @return 1 if it is a dead end, 0 otherwise
- */
-int is_dead_end(int x, int y, const map_t* map_to_check);
+void place_fountain(const map_t* map_to_populate, candidates_t* dead_ends, candidates_t* floors);
 
 /**
- * Checks if the specified position in the map is a floor tile.
- * @param x the x-coordinate of the position to check
- * @param y the y-coordinate of the position to check
- * @param map_to_check the map structure to examine
- * @return 1 if the tile at the specified position is a floor, 0 otherwise
+ * Draws random candidates without replacement, until one of them is still a floor tile.
+ * Every candidate is drawn at most once, so all draws together are linear in the number of candidates.
+ * @param map_to_check the map the candidates belong to
+ * @param candidates the candidates to draw from
+ * @param cell receives the drawn cell
+ * @return 1 if a floor cell was drawn, 0 if there are no candidates left
  */
-int is_not_floor(int x, int y, const map_t* map_to_check);
+int draw_candidate(const map_t* map_to_check, candidates_t* candidates, vector2d_t* cell);
 
 /**
- * Checks if the given coordinates are within a minimum distance to an enemy
- * or a start door on the map.
- * @param x the x-coordinate to check
- * @param y the y-coordinate to check
- * @param map_to_check the map structure to evaluate for nearby enemies or start doors
- * @return 1 if an enemy or a start door is within the minimum distance, 0 otherwise
+ * Lowers the distance grid around the given position to the chebyshev distance from it.
+ * @param map_to_check the map the grid belongs to
+ * @param distances the distance grid, with the same index as the tiles
+ * @param x the x-coordinate of the enemy or start door
+ * @param y the y-coordinate of the enemy or start door
  */
-int is_close_to_enemy(int x, int y, const map_t* map_to_check);
+void mark_enemy_distance(const map_t* map_to_check, unsigned char* distances, int x, int y);
 
 
 int populate_map(map_t* map_to_populate) {
     RETURN_WHEN_NULL(map_to_populate, 1, "Map Populator", "Map to populate is NULL");
     RETURN_WHEN_NULL(map_to_populate->hidden_tiles, 1, "Map Populator", "Map to populate is not initialized");
 
-    place_key(map_to_populate);
-    place_enemy(map_to_populate);
-    place_fountain(map_to_populate);
+    const int width = map_to_populate->width;
+    const int height = map_to_populate->height;
+
+    //collect the candidates of the whole map in one pass, the storage lives on the stack like in add_map_loops
+    uint64_t open_bits[BITBOARD_SIZE(width, height)];
+    uint64_t dead_end_bits[BITBOARD_SIZE(width, height)];
+    bitboard_t open;
+    bitboard_t dead_end_board;
+    init_bitboard(&open, open_bits, width, height);
+    init_bitboard(&dead_end_board, dead_end_bits, width, height);
+    fill_open_bitboard(&open, map_to_populate->hidden_tiles);
+    find_dead_ends_bitboard(&open, &dead_end_board);
+
+    const int open_count = count_bitboard(&open);
+    const int dead_end_count = count_bitboard(&dead_end_board);
+    vector2d_t floor_cells[open_count > 0 ? open_count : 1];
+    vector2d_t dead_end_cells[dead_end_count > 0 ? dead_end_count : 1];
+    candidates_t floors = {floor_cells, bitboard_to_list(&open, floor_cells, open_count)};
+    candidates_t dead_ends = {dead_end_cells, bitboard_to_list(&dead_end_board, dead_end_cells, dead_end_count)};
+
+    place_key(map_to_populate, &dead_ends, &floors);
+    place_enemy(map_to_populate, &floors);
+    place_fountain(map_to_populate, &dead_ends, &floors);
 
     return 0;
 }
 
-void place_key(const map_t* map_to_populate) {
-    int x = 0;
-    int y = 0;
-
-    do {
-        x = rand() % (map_to_populate->width - 2) + 1;
-        y = rand() % (map_to_populate->height - 2) + 1;
-    } while (is_not_floor(x, y, map_to_populate) && !is_dead_end(x, y, map_to_populate));
+void place_key(const map_t* map_to_populate, candidates_t* dead_ends, candidates_t* floors) {
+    vector2d_t cell;
+    if (!draw_candidate(map_to_populate, dead_ends, &cell) && !draw_candidate(map_to_populate, floors, &cell)) {
+        log_msg(WARNING, "Map Populator", "No free floor tile left for the key");
+        return;
+    }
 
-    map_to_populate->hidden_tiles[x * map_to_populate->height + y] = DOOR_KEY;
-    DEBUG_LOG("Map Populator", "Key placed at %d, %d", x, y);
+    map_to_populate->hidden_tiles[cell.dx * map_to_populate->height + cell.dy] = DOOR_KEY;
+    DEBUG_LOG("Map Populator", "Key placed at %d, %d", cell.dx, cell.dy);
 }
 
-void place_enemy(map_t* map_to_populate) {
+void place_enemy(map_t* map_to_populate, candidates_t* floors) {
     //if the defined enemy count is smaller than 0, set it to the standard enemy count
     if (map_to_populate->enemy_count <= 0) {
         map_to_populate->enemy_count = STANDARD_ENEMY_COUNT;
     }
 
-    for (int i = 0; i < map_to_populate->enemy_count; i++) {
-        int x = 0;
-        int y = 0;
-
-        do {
-            x = rand() % (map_to_populate->width - 2) + 1;
-            y = rand() % (map_to_populate->height - 2) + 1;
-        } while (is_not_floor(x, y, map_to_populate) || is_close_to_enemy(x, y, map_to_populate));
-
-        map_to_populate->hidden_tiles[x * map_to_populate->height + y] = ENEMY;
+    const int tile_count = map_to_populate->width * map_to_populate->height;
+    unsigned char distances[tile_count];
+    memset(distances, FAR_AWAY, sizeof(distances));
+    for (int i = 0; i < tile_count; i++) {
+        if (map_to_populate->hidden_tiles[i] == START_DOOR) {
+            mark_enemy_distance(map_to_populate, distances, i / map_to_populate->height, i % map_to_populate->height);
+        }
     }
-}
-
-void place_fountain(const map_t* map_to_populate) {
-    int x = 0;
-    int y = 0;
 
-    do {
-        x = rand() % (map_to_populate->width - 2) + 1;
-        y = rand() % (map_to_populate->height - 2) + 1;
-    } while (is_not_floor(x, y, map_to_populate) && !is_dead_end(x, y, map_to_populate));
+    int placed = 0;
+    vector2d_t cell;
+    while (placed < map_to_populate->enemy_count && draw_candidate(map_to_populate, floors, &cell)) {
+        //a rejected candidate stays too close for the rest of the placement, so it's never drawn again
+        if (distances[cell.dx * map_to_populate->height + cell.dy] <= ENEMY_MIN_DISTANCE) continue;
 
-    map_to_populate->hidden_tiles[x * map_to_populate->height + y] = LIFE_FOUNTAIN;
-
-    do {
-        x = rand() % (map_to_populate->width - 2) + 1;
-        y = rand() % (map_to_populate->height - 2) + 1;
-    } while (is_not_floor(x, y, map_to_populate) && !is_dead_end(x, y, map_to_populate));
+        map_to_populate->hidden_tiles[cell.dx * map_to_populate->height + cell.dy] = ENEMY;
+        mark_enemy_distance(map_to_populate, distances, cell.dx, cell.dy);
+        placed++;
+    }
 
-    map_to_populate->hidden_tiles[x * map_to_populate->height + y] = MANA_FOUNTAIN;
+    if (placed < map_to_populate->enemy_count) {
+        log_msg(WARNING, "Map Populator", "Only %d of %d enemies fit on map %d", placed,
+                map_to_populate->enemy_count, map_to_populate->floor_nr);
+        map_to_populate->enemy_count = placed;
+    }
 }
 
-int is_dead_end(const int x, const int y, const map_t* map_to_check) {
-    // Count neighboring non-wall cells
-    int neighbor_count = 0;
-
-    for (int i = 0; i < 4; i++) {
-        const int dx = x + directions[i].dx;
-        const int dy = y + directions[i].dy;
-
-        const int map_idx = dx * map_to_check->height + dy;
+void place_fountain(const map_t* map_to_populate, candidates_t* dead_ends, candidates_t* floors) {
+    const map_tile_t fountains[] = {LIFE_FOUNTAIN, MANA_FOUNTAIN};
 
-        if (map_to_check->hidden_tiles[map_idx] != WALL) {
-            neighbor_count++;
+    for (int i = 0; i < 2; i++) {
+        vector2d_t cell;
+        if (!draw_candidate(map_to_populate, dead_ends, &cell) && !draw_candidate(map_to_populate, floors, &cell)) {
+            log_msg(WARNING, "Map Populator", "No free floor tile left for a fountain");
+            return;
         }
+        map_to_populate->hidden_tiles[cell.dx * map_to_populate->height + cell.dy] = fountains[i];
     }
-
-    return neighbor_count == 1;
 }
 
-int is_not_floor(const int x, const int y, const map_t* map_to_check) {
-    return map_to_check->hidden_tiles[x * map_to_check->height + y] != FLOOR;
+int draw_candidate(const map_t* map_to_check, candidates_t* candidates, vector2d_t* cell) {
+    while (candidates->remaining > 0) {
+        //swap the drawn cell behind the remaining ones, so it can't be drawn again
+        const int pick = map_rand() % candidates->remaining;
+        *cell = candidates->cells[pick];
+        candidates->cells[pick] = candidates->cells[--candidates->remaining];
+
+        //the list is built once, so cells taken by other elements are skipped here
+        if (map_to_check->hidden_tiles[cell->dx * map_to_check->height + cell->dy] == FLOOR) return 1;
+    }
+    return 0;
 }
 
-int is_close_to_enemy(const int x, const int y, const map_t* map_to_check) {
-    for (int i = -ENEMY_MIN_DISTANCE; i <= ENEMY_MIN_DISTANCE + 1; i++) {
-        for (int j = -ENEMY_MIN_DISTANCE; j <= ENEMY_MIN_DISTANCE + 1; j++) {
-            const int map_idx = (x + i) * map_to_check->height + (y + j);
-            if (map_to_check->hidden_tiles[map_idx] == ENEMY || map_to_check->hidden_tiles[map_idx] == START_DOOR) {
-                return 1;
-            }
+void mark_enemy_distance(const map_t* map_to_check, unsigned char* distances, const int x, const int y) {
+    for (int i = -ENEMY_MIN_DISTANCE; i <= ENEMY_MIN_DISTANCE; i++) {
+        for (int j = -ENEMY_MIN_DISTANCE; j <= ENEMY_MIN_DISTANCE; j++) {
+            if (x + i < 0 || x + i >= map_to_check->width || y + j < 0 || y + j >= map_to_check->height) continue;
+            const int distance = abs(i) > abs(j) ? abs(i) : abs(j);
+            unsigned char* current = &distances[(x + i) * map_to_check->height + (y + j)];
+            if (distance < *current) *current = (unsigned char) distance;
         }
     }
-    return 0;
 }
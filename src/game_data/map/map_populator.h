@@ -6,6 +6,8 @@
 /**
  * Populates the given map with necessary game elements such as keys, enemies, and fountains.
  * The function validates the map before adding these elements and ensures the map is properly initialized.
+ * The floor and dead end candidates are collected in one pass and drawn without replacement,
+ * so the population time is linear in the map size, also on crowded or tiny maps.
  *
  * @param map_to_populate A pointer to the map to be populated.
  * The map must have its hidden_tiles field initialized before calling this function.
@@ -0,0 +1,25 @@
+#include "map_random.h"
+
+#include <stdlib.h>
+
+#define ZERO_SEED_REPLACEMENT 0x9E3779B9u
+
+// the state of the xorshift generator, 0 means not seeded
+_Thread_local unsigned int map_rand_state = 0;
+
+int map_rand(void) {
+    if (map_rand_state == 0) {
+        seed_map_rand((unsigned int) rand());
+    }
+
+    unsigned int x = map_rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    map_rand_state = x;
+    return (int) (x >> 1);// drop the sign bit, like rand() never returns negative values
+}
+
+void seed_map_rand(const unsigned int seed) {
+    map_rand_state = seed == 0 ? ZERO_SEED_REPLACEMENT : seed;
+}
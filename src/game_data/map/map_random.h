@@ -0,0 +1,20 @@
+#ifndef MAP_RANDOM_H
+#define MAP_RANDOM_H
+
+/**
+ * Returns the next pseudo random number of the calling thread, in the same range as rand().
+ * The state is thread local, so maps can be generated on several threads at once. When the state
+ * of a thread was never seeded, it is seeded from rand(), so srand() still controls the map generation.
+ *
+ * @return A non-negative pseudo random number.
+ */
+int map_rand(void);
+
+/**
+ * Seeds the pseudo random number generator of the calling thread.
+ *
+ * @param seed The seed, 0 is replaced by a fixed non-zero value.
+ */
+void seed_map_rand(unsigned int seed);
+
+#endif//MAP_RANDOM_H
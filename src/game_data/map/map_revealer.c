@@ -2,6 +2,9 @@
 
 #include "../../logger/logger.h"
 
+#include <stdatomic.h>
+#include <string.h>
+
 static const vector2d_t check_vectors[4][2] = {
         {{1, 1}, {1, 0}},   // for up
         {{-1, -1}, {-1, 0}},// for down
@@ -22,10 +25,104 @@ static const vector2d_t check_vectors[4][2] = {
  */
 int need_loop_break(int x, int y, vector2d_t dir, int j, int* prev_wall_at);
 
+#define NORTH 0
+#define SOUTH 1
+#define EAST 2
+#define WEST 3
+
+#define LIGHT_SIDE_MAX (2 * MAX_LIGHT_RADIUS + 1)// side length of the largest light square
+
+typedef struct {
+    int num;
+    int den;// always positive
+} slope_t;
+
+typedef struct {
+    int origin_x;
+    int origin_y;
+    int quadrant;         // NORTH, SOUTH, EAST or WEST
+    int radius;
+    const int* col_limits;// col_limits[depth] = the largest column of the row inside the light radius
+    int origin_index;     // index of the origin in the tile arrays, only used for direct access
+    int depth_step;       // index offset of one row further away from the origin, only used for direct access
+    int col_step;         // index offset of the next column, only used for direct access
+    uint64_t* visible;    // the visible tiles of the light square, one bit per tile, only used for direct access
+    int visible_origin;   // index of the origin in the light square
+    int visible_depth_step;// like `depth_step` and `col_step`, but for the light square
+    int visible_col_step;
+} shadowcast_t;
+
+#define LIGHT_TABLE_EMPTY 0
+#define LIGHT_TABLE_FILLING 1
+#define LIGHT_TABLE_READY 2
+
+static int light_tables[MAX_LIGHT_RADIUS + 1][MAX_LIGHT_RADIUS + 1];
+static atomic_int light_table_states[MAX_LIGHT_RADIUS + 1];// LIGHT_TABLE_EMPTY, _FILLING or _READY
+
+/**
+ * Returns the column limits of the light radius, see `shadowcast_t.col_limits`. The table of each radius
+ * is only calculated on the first call, all later calls just return it. Safe to call from several threads,
+ * the first caller fills the table and concurrent callers wait until it is ready.
+ *
+ * @param light_radius The light radius, at most MAX_LIGHT_RADIUS.
+ * @return The column limits for the depths 0 to light_radius.
+ */
+const int* get_light_table(int light_radius);
+
+/**
+ * Returns the slot of the given position in the lit origins of a map.
+ *
+ * @param x The x-coordinate of the position.
+ * @param y The y-coordinate of the position.
+ * @return The slot index.
+ */
+int get_lit_origin_slot(int x, int y);
+
+/**
+ * Scans one row of a quadrant between the start and end slope and recursively the rows behind it.
+ * Every wall splits the visible part, the rows behind each part are scanned with narrowed slopes.
+ *
+ * @param map The map to reveal.
+ * @param cast The origin, quadrant and radius of the shadowcast.
+ * @param depth The distance of the row from the origin.
+ * @param start The slope of the first visible column.
+ * @param end The slope of the last visible column.
+ */
+void scan_row(const map_t* map, const shadowcast_t* cast, int depth, slope_t start, slope_t end);
+
+/**
+ * Like `scan_row`, but accesses the tile arrays directly through the offsets of the cast. Only valid
+ * if the whole light square lies inside the map.
+ */
+void scan_row_direct(const map_t* map, const shadowcast_t* cast, int depth, slope_t start, slope_t end);
+
+/**
+ * ORs a range of bits from one mask into another, 64 bits at a time. Neither range has to start on a word border.
+ *
+ * @param dst The mask receiving the bits.
+ * @param dst_start The index of the first bit in `dst`.
+ * @param src The mask providing the bits.
+ * @param src_start The index of the first bit in `src`.
+ * @param count The number of bits.
+ */
+void or_mask_bits(uint64_t* dst, int dst_start, const uint64_t* src, int src_start, int count);
+
+/**
+ * Converts a row and column of a quadrant to map coordinates.
+ */
+vector2d_t transform_quadrant(const shadowcast_t* cast, int depth, int col);
+
+/**
+ * @return a / b rounded towards negative infinity, b must be positive.
+ */
+int floor_div(int a, int b);
+
 int reveal_map(const map_t* map_to_reveal, const int light_radius) {
     RETURN_WHEN_NULL(map_to_reveal, 1, "Map Revealer", "Map to reveal is NULL");
-    RETURN_WHEN_NULL(map_to_reveal->hidden_tiles, 1, "Map Revealer", "Map to reveal is not initialized");
-    RETURN_WHEN_NULL(map_to_reveal->revealed_tiles, 1, "Map Revealer", "Revealed map is not initialized");
+    RETURN_WHEN_TRUE(map_to_reveal->chunks == NULL && map_to_reveal->hidden_tiles == NULL, 1,
+                     "Map Revealer", "Map to reveal is not initialized");
+    RETURN_WHEN_TRUE(map_to_reveal->chunks == NULL && map_to_reveal->revealed_mask == NULL, 1,
+                     "Map Revealer", "Revealed map is not initialized");
     RETURN_WHEN_TRUE(map_to_reveal->width <= 0, 1, "Map Revealer", "Width must be greater than 0");
     RETURN_WHEN_TRUE(map_to_reveal->height <= 0, 1, "Map Revealer", "Height must be greater than 0");
 
@@ -68,13 +165,12 @@ int reveal_map(const map_t* map_to_reveal, const int light_radius) {
                     break;
                 }
 
-                //calculated access index
-                const int access_idx = x * height + y;
+                const map_tile_t revealed = get_revealed_tile(map_to_reveal, x, y);
 
-                if (map_to_reveal->revealed_tiles[access_idx] == HIDDEN) {
+                if (revealed == HIDDEN) {
                     //initialize the relative diagonal and reverse tiles based on the y and x values
-                    const int rel_diagonal = map_to_reveal->hidden_tiles[(x + diagonal_check.dx) * height + y + diagonal_check.dy];
-                    const int rel_reverse = map_to_reveal->hidden_tiles[(x + reverse_check.dx) * height + y + reverse_check.dy];
+                    const map_tile_t rel_diagonal = get_hidden_tile(map_to_reveal, x + diagonal_check.dx, y + diagonal_check.dy);
+                    const map_tile_t rel_reverse = get_hidden_tile(map_to_reveal, x + reverse_check.dx, y + reverse_check.dy);
 
                     if (rel_diagonal == WALL && rel_reverse == WALL && j > 1) {
                         //if the diagonal and reverse tiles are walls, and the distance from the player is greater than 1
@@ -82,49 +178,15 @@ int reveal_map(const map_t* map_to_reveal, const int light_radius) {
                         break;
                     }
 
-                    // if set to 1 break loop
-                    int break_loop = 0;
-
-                    switch (map_to_reveal->hidden_tiles[access_idx]) {
-                        case WALL:
-                            map_to_reveal->revealed_tiles[access_idx] = WALL;
-
-                            if (need_loop_break(x, y, dir, j, &prev_wall_at)) {
-                                break_loop = 1;
-                            }
-                            break;
-                        case FLOOR:
-                            map_to_reveal->revealed_tiles[access_idx] = FLOOR;
-                            break;
-                        case START_DOOR:
-                            map_to_reveal->revealed_tiles[access_idx] = START_DOOR;
-                            break;
-                        case EXIT_DOOR:
-                            map_to_reveal->revealed_tiles[access_idx] = EXIT_DOOR;
-                            break;
-                        case DOOR_KEY:
-                            map_to_reveal->revealed_tiles[access_idx] = DOOR_KEY;
-                            break;
-                        case ENEMY:
-                            map_to_reveal->revealed_tiles[access_idx] = ENEMY;
-                            break;
-                        case LIFE_FOUNTAIN:
-                            map_to_reveal->revealed_tiles[access_idx] = LIFE_FOUNTAIN;
-                            break;
-                        case MANA_FOUNTAIN:
-                            map_to_reveal->revealed_tiles[access_idx] = MANA_FOUNTAIN;
-                            break;
-                        case STAMINA_FOUNTAIN:
-                            map_to_reveal->revealed_tiles[access_idx] = STAMINA_FOUNTAIN;
-                            break;
-                        default:
-                            //does nothing
-                            break;
+                    const map_tile_t tile = get_hidden_tile(map_to_reveal, x, y);
+                    if (tile != PLAYER && tile != HIDDEN) {
+                        //only real map tiles can be revealed
+                        reveal_tile(map_to_reveal, x, y);
                     }
-                    if (break_loop) {
+                    if (tile == WALL && need_loop_break(x, y, dir, j, &prev_wall_at)) {
                         break;
                     }
-                } else if (map_to_reveal->revealed_tiles[access_idx] == WALL && need_loop_break(x, y, dir, j, &prev_wall_at)) {
+                } else if (revealed == WALL && need_loop_break(x, y, dir, j, &prev_wall_at)) {
                     break;
                 }
             }
@@ -149,3 +211,238 @@ int need_loop_break(const int x, const int y, const vector2d_t dir, const int j,
     }
     return 0;
 }
+
+int reveal_map_step(map_t* map_to_reveal, const vector2d_t delta, const int light_radius) {
+    RETURN_WHEN_NULL(map_to_reveal, 1, "Map Revealer", "Map to reveal is NULL");
+
+    if (light_radius <= 0 || (delta.dx == 0 && delta.dy == 0)) {
+        return 0;
+    }
+    const vector2d_t pos = map_to_reveal->player_pos;
+    vector2d_t* origin = &map_to_reveal->lit_origins[get_lit_origin_slot(pos.dx, pos.dy)];
+
+    if (map_to_reveal->lit_radius != light_radius) {
+        //the recorded origins were lit with another radius
+        forget_lit_origins(map_to_reveal);
+        map_to_reveal->lit_radius = light_radius;
+    } else if (origin->dx == pos.dx && origin->dy == pos.dy) {
+        //already lit from here, e.g. while backtracking through explored corridors
+        return 0;
+    }
+
+    const int result = reveal_map_shadowcast(map_to_reveal, light_radius);
+    if (result == 0) {
+        *origin = pos;
+        const int radius = light_radius < MAX_LIGHT_RADIUS ? light_radius : MAX_LIGHT_RADIUS;
+        record_reveal_event(map_to_reveal, pos.dx - radius, pos.dy - radius, 2 * radius + 1, 2 * radius + 1);
+    }
+    return result;
+}
+
+void forget_lit_origins(map_t* map) {
+    RETURN_WHEN_NULL(map, , "Map Revealer", "Map is NULL")
+    //(0, 0) is always part of the outer wall, so the player can never be lit from there
+    memset(map->lit_origins, 0, sizeof(map->lit_origins));
+    map->lit_radius = 0;
+}
+
+int get_lit_origin_slot(const int x, const int y) {
+    return (x * 17 + y) & (LIT_ORIGIN_SLOTS - 1);
+}
+
+int reveal_map_shadowcast(const map_t* map_to_reveal, const int light_radius) {
+    RETURN_WHEN_NULL(map_to_reveal, 1, "Map Revealer", "Map to reveal is NULL");
+    RETURN_WHEN_TRUE(map_to_reveal->chunks == NULL && map_to_reveal->hidden_tiles == NULL, 1,
+                     "Map Revealer", "Map to reveal is not initialized");
+    RETURN_WHEN_TRUE(map_to_reveal->chunks == NULL && map_to_reveal->revealed_mask == NULL, 1,
+                     "Map Revealer", "Revealed map is not initialized");
+    RETURN_WHEN_TRUE(map_to_reveal->width <= 0, 1, "Map Revealer", "Width must be greater than 0");
+    RETURN_WHEN_TRUE(map_to_reveal->height <= 0, 1, "Map Revealer", "Height must be greater than 0");
+
+    if (light_radius <= 0) {
+        return 0;
+    }
+
+    const int radius = light_radius < MAX_LIGHT_RADIUS ? light_radius : MAX_LIGHT_RADIUS;
+    const int player_x = map_to_reveal->player_pos.dx;
+    const int player_y = map_to_reveal->player_pos.dy;
+    const int height = map_to_reveal->height;
+
+    const map_tile_t origin = get_hidden_tile(map_to_reveal, player_x, player_y);
+    if (origin != PLAYER && origin != HIDDEN) {
+        reveal_tile(map_to_reveal, player_x, player_y);
+    }
+
+    //the bounds are only checked once, if the light square fits the map no tile access needs a check
+    const int direct = map_to_reveal->chunks == NULL && player_x - radius >= 0 && player_y - radius >= 0 &&
+                       player_x + radius < map_to_reveal->width && player_y + radius < height;
+    //index offsets of one step in depth and in column direction for each quadrant
+    const vector2d_t steps[4] = {
+            [NORTH] = {-1, height},
+            [SOUTH] = {1, height},
+            [EAST] = {height, 1},
+            [WEST] = {-height, 1},
+    };
+    //the direct path collects the visible tiles of the light square and merges each of its columns into the
+    //revealed mask with word wide ORs, a light square column is a contiguous bit range of a map column
+    const int side = 2 * radius + 1;
+    uint64_t visible[MASK_WORDS(LIGHT_SIDE_MAX * LIGHT_SIDE_MAX)];
+    if (direct) memset(visible, 0, MASK_WORDS(side * side) * sizeof(uint64_t));
+    const vector2d_t visible_steps[4] = {
+            [NORTH] = {-1, side},
+            [SOUTH] = {1, side},
+            [EAST] = {side, 1},
+            [WEST] = {-side, 1},
+    };
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        const shadowcast_t cast = {player_x, player_y, quadrant, radius, get_light_table(radius),
+                                   player_x * height + player_y, steps[quadrant].dx, steps[quadrant].dy,
+                                   visible, radius * side + radius, visible_steps[quadrant].dx,
+                                   visible_steps[quadrant].dy};
+        if (direct) {
+            scan_row_direct(map_to_reveal, &cast, 1, (slope_t) {-1, 1}, (slope_t) {1, 1});
+        } else {
+            scan_row(map_to_reveal, &cast, 1, (slope_t) {-1, 1}, (slope_t) {1, 1});
+        }
+    }
+    if (direct) {
+        for (int col = 0; col < side; col++) {
+            or_mask_bits(map_to_reveal->revealed_mask, (player_x - radius + col) * height + player_y - radius,
+                         visible, col * side, side);
+        }
+    }
+    return 0;
+}
+
+const int* get_light_table(const int light_radius) {
+    int* limits = light_tables[light_radius];
+    atomic_int* state = &light_table_states[light_radius];
+    //the acquire pairs with the release below, so a ready table is seen completely
+    if (atomic_load_explicit(state, memory_order_acquire) == LIGHT_TABLE_READY) return limits;
+
+    int expected = LIGHT_TABLE_EMPTY;
+    if (atomic_compare_exchange_strong_explicit(state, &expected, LIGHT_TABLE_FILLING, memory_order_acquire,
+                                                memory_order_acquire)) {
+        //a column is inside the light radius if col^2 + depth^2 <= radius^2 + radius
+        const int max_distance = light_radius * light_radius + light_radius;
+        for (int depth = 0; depth <= light_radius; depth++) {
+            int col = 0;
+            while ((col + 1) * (col + 1) + depth * depth <= max_distance) {
+                col++;
+            }
+            limits[depth] = col;
+        }
+        atomic_store_explicit(state, LIGHT_TABLE_READY, memory_order_release);
+        return limits;
+    }
+    //another thread fills the table, which only takes a few hundred operations
+    while (atomic_load_explicit(state, memory_order_acquire) != LIGHT_TABLE_READY) {}
+    return limits;
+}
+
+void scan_row(const map_t* map, const shadowcast_t* cast, const int depth, slope_t start, const slope_t end) {
+    if (depth > cast->radius) return;
+
+    //the columns touched by the slopes, ties are rounded towards the inside of the row
+    const int min_col = floor_div(2 * depth * start.num + start.den, 2 * start.den);
+    const int max_col = -floor_div(end.den - 2 * depth * end.num, 2 * end.den);
+    //the diagonals are shared with the neighbouring quadrant, only north and south reveal them
+    const int owns_diagonals = cast->quadrant == NORTH || cast->quadrant == SOUTH;
+
+    int prev_wall = -1;// -1 = no previous tile, 0 = floor, 1 = wall
+    for (int col = min_col; col <= max_col; col++) {
+        const vector2d_t pos = transform_quadrant(cast, depth, col);
+        const map_tile_t tile = get_hidden_tile(map, pos.dx, pos.dy);
+        const int wall = tile == WALL;
+        //floors are only visible, when their center lies between the slopes, so the result is symmetric
+        const int symmetric = col * start.den >= depth * start.num && col * end.den <= depth * end.num;
+        const int in_radius = abs(col) <= cast->col_limits[depth];
+
+        if ((wall || symmetric) && in_radius && (owns_diagonals || (col != depth && col != -depth)) &&
+            tile != PLAYER && tile != HIDDEN) {
+            reveal_tile(map, pos.dx, pos.dy);
+        }
+        if (prev_wall == 1 && !wall) {
+            //the first floor after a wall starts the next visible part
+            start = (slope_t) {2 * col - 1, 2 * depth};
+        }
+        if (prev_wall == 0 && wall) {
+            //a wall ends the visible part, the rows behind it are scanned first
+            scan_row(map, cast, depth + 1, start, (slope_t) {2 * col - 1, 2 * depth});
+        }
+        prev_wall = wall;
+    }
+    if (prev_wall == 0) {
+        scan_row(map, cast, depth + 1, start, end);
+    }
+}
+
+void scan_row_direct(const map_t* map, const shadowcast_t* cast, const int depth, slope_t start, const slope_t end) {
+    if (depth > cast->radius) return;
+
+    const int min_col = floor_div(2 * depth * start.num + start.den, 2 * start.den);
+    const int max_col = -floor_div(end.den - 2 * depth * end.num, 2 * end.den);
+    const int owns_diagonals = cast->quadrant == NORTH || cast->quadrant == SOUTH;
+    const int col_limit = cast->col_limits[depth];
+    const int row_index = cast->origin_index + depth * cast->depth_step;
+    const int visible_row = cast->visible_origin + depth * cast->visible_depth_step;
+
+    int prev_wall = -1;// -1 = no previous tile, 0 = floor, 1 = wall
+    for (int col = min_col; col <= max_col; col++) {
+        const int index = row_index + col * cast->col_step;
+        const map_tile_t tile = map->hidden_tiles[index];
+        const int wall = tile == WALL;
+        const int symmetric = col * start.den >= depth * start.num && col * end.den <= depth * end.num;
+
+        if ((wall || symmetric) && abs(col) <= col_limit && (owns_diagonals || (col != depth && col != -depth)) &&
+            tile != PLAYER && tile != HIDDEN) {
+            SET_REVEALED(cast->visible, visible_row + col * cast->visible_col_step);
+        }
+        if (prev_wall == 1 && !wall) {
+            start = (slope_t) {2 * col - 1, 2 * depth};
+        }
+        if (prev_wall == 0 && wall) {
+            scan_row_direct(map, cast, depth + 1, start, (slope_t) {2 * col - 1, 2 * depth});
+        }
+        prev_wall = wall;
+    }
+    if (prev_wall == 0) {
+        scan_row_direct(map, cast, depth + 1, start, end);
+    }
+}
+
+void or_mask_bits(uint64_t* dst, const int dst_start, const uint64_t* src, const int src_start, const int count) {
+    for (int done = 0; done < count; done += 64) {
+        const int n = count - done < 64 ? count - done : 64;
+        const int src_bit = src_start + done;
+        const int dst_bit = dst_start + done;
+        const int src_shift = src_bit & 63;
+        const int dst_shift = dst_bit & 63;
+
+        //gather n bits from up to two source words, the second word is only read if the range reaches it
+        uint64_t bits = src[src_bit >> 6] >> src_shift;
+        if (src_shift != 0 && src_shift + n > 64) bits |= src[(src_bit >> 6) + 1] << (64 - src_shift);
+        if (n < 64) bits &= ((uint64_t) 1 << n) - 1;
+        if (bits == 0) continue;
+
+        dst[dst_bit >> 6] |= bits << dst_shift;
+        if (dst_shift != 0 && dst_shift + n > 64) dst[(dst_bit >> 6) + 1] |= bits >> (64 - dst_shift);
+    }
+}
+
+vector2d_t transform_quadrant(const shadowcast_t* cast, const int depth, const int col) {
+    switch (cast->quadrant) {
+        case NORTH:
+            return (vector2d_t) {cast->origin_x + col, cast->origin_y - depth};
+        case SOUTH:
+            return (vector2d_t) {cast->origin_x + col, cast->origin_y + depth};
+        case EAST:
+            return (vector2d_t) {cast->origin_x + depth, cast->origin_y + col};
+        default:
+            return (vector2d_t) {cast->origin_x - depth, cast->origin_y + col};
+    }
+}
+
+int floor_div(const int a, const int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
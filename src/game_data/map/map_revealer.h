@@ -3,10 +3,12 @@
 
 #include "map.h"
 
+#define MAX_LIGHT_RADIUS 64// larger light radii are clamped by reveal_map_shadowcast
+
 /**
  * Reveals the tiles within a given light radius around the player's position
  * on the provided map. The method ensures tiles within the revealed radius
- * are updated from hidden to visible on the `revealed_tiles` array.
+ * are marked as visible in the `revealed_mask`.
  *
  * @param map_to_reveal Pointer to the map structure representing the current
  *        game or environment. It contains the player's position, dimensions,
@@ -19,4 +21,39 @@
  */
 int reveal_map(const map_t* map_to_reveal, int light_radius);
 
+/**
+ * Reveals the map with `reveal_map_shadowcast` after the player moved by the given delta. The shadowcast only
+ * depends on the walls, so a position it was already cast from can't reveal anything new. The map remembers
+ * the recent origins in `lit_origins` and returns early when the player steps onto one of them again, e.g.
+ * while backtracking through explored corridors. Every cast is recorded as a reveal event covering the light square.
+ *
+ * @param map_to_reveal Pointer to the map, the player position must already be updated.
+ * @param delta The movement of the player, nothing is revealed when it is zero.
+ * @param light_radius The radius of light around the player's position.
+ * @return Returns 0 if the operation is successful, or 1 if invalid inputs are detected.
+ */
+int reveal_map_step(map_t* map_to_reveal, vector2d_t delta, int light_radius);
+
+/**
+ * Clears the recorded origins of `reveal_map_step`. Must be called whenever the revealed tiles of a map
+ * are reset or replaced.
+ *
+ * @param map The map.
+ */
+void forget_lit_origins(map_t* map);
+
+/**
+ * Alternative to `reveal_map` using symmetric recursive shadowcasting. The light radius is split into
+ * four quadrants, each scanned row by row, so every tile inside the radius is revealed at most once.
+ * A floor tile is revealed, if the player can see it and it could see the player (symmetry),
+ * walls are revealed as soon as any part of them is visible.
+ * The extent of the light radius in each row comes from a table calculated once per radius. When the
+ * light square lies inside a map without chunks, the tiles are accessed without any further bounds checks.
+ *
+ * @param map_to_reveal Pointer to the map, containing the player's position.
+ * @param light_radius The radius of light around the player's position, clamped to MAX_LIGHT_RADIUS.
+ * @return Returns 0 if the operation is successful, or 1 if invalid inputs are detected.
+ */
+int reveal_map_shadowcast(const map_t* map_to_reveal, int light_radius);
+
 #endif//MAP_REVEALER_H
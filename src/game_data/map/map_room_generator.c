@@ -0,0 +1,72 @@
+#include "map_room_generator.h"
+
+#include "map_generator.h"
+#include "map_random.h"
+
+#define MIN_LEAF_SIZE 8// a partition is only split, when both halves are at least this large
+#define MIN_ROOM_SIZE 3
+
+/**
+ * Recursively splits the area into two partitions along its longer side, until it is too small
+ * to be split. Each leaf gets a room with a random size and position, leaving at least one wall
+ * to the next partition. After both halves are carved, they are connected by a corridor.
+ *
+ * @param map The map to carve.
+ * @param x The left column of the area.
+ * @param y The top row of the area.
+ * @param width The width of the area.
+ * @param height The height of the area.
+ * @return The center of a room inside the area, used to connect it to its sibling.
+ */
+vector2d_t split_rooms(const map_t* map, int x, int y, int width, int height);
+
+/**
+ * Fills the given rectangle with floor tiles.
+ */
+void carve_room(const map_t* map, int x, int y, int width, int height);
+
+void carve_rooms(map_t* map) {
+    const vector2d_t room = split_rooms(map, 1, 1, map->width - 2, map->height - 2);
+    carve_corridor(map, map->entry_pos, room);
+}
+
+vector2d_t split_rooms(const map_t* map, const int x, const int y, const int width, const int height) {
+    const int can_split_x = width >= 2 * MIN_LEAF_SIZE;
+    const int can_split_y = height >= 2 * MIN_LEAF_SIZE;
+
+    if (!can_split_x && !can_split_y) {
+        //leaf, the room keeps a wall to the right and to the bottom, so rooms of neighbouring leaves don't merge
+        const int max_width = width - 1 > MIN_ROOM_SIZE ? width - 1 : MIN_ROOM_SIZE;
+        const int max_height = height - 1 > MIN_ROOM_SIZE ? height - 1 : MIN_ROOM_SIZE;
+        const int room_width = MIN_ROOM_SIZE + map_rand() % (max_width - MIN_ROOM_SIZE + 1);
+        const int room_height = MIN_ROOM_SIZE + map_rand() % (max_height - MIN_ROOM_SIZE + 1);
+        const int room_x = x + map_rand() % (max_width - room_width + 1);
+        const int room_y = y + map_rand() % (max_height - room_height + 1);
+
+        carve_room(map, room_x, room_y, room_width, room_height);
+        return (vector2d_t) {room_x + room_width / 2, room_y + room_height / 2};
+    }
+
+    vector2d_t first;
+    vector2d_t second;
+    if (can_split_x && (!can_split_y || width >= height)) {
+        const int split = MIN_LEAF_SIZE + map_rand() % (width - 2 * MIN_LEAF_SIZE + 1);
+        first = split_rooms(map, x, y, split, height);
+        second = split_rooms(map, x + split, y, width - split, height);
+    } else {
+        const int split = MIN_LEAF_SIZE + map_rand() % (height - 2 * MIN_LEAF_SIZE + 1);
+        first = split_rooms(map, x, y, width, split);
+        second = split_rooms(map, x, y + split, width, height - split);
+    }
+
+    carve_corridor(map, first, second);
+    return map_rand() % 2 ? first : second;
+}
+
+void carve_room(const map_t* map, const int x, const int y, const int width, const int height) {
+    for (int i = x; i < x + width && i < map->width - 1; i++) {
+        for (int j = y; j < y + height && j < map->height - 1; j++) {
+            map->hidden_tiles[i * map->height + j] = FLOOR;
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef MAP_ROOM_GENERATOR_H
+#define MAP_ROOM_GENERATOR_H
+
+#include "map.h"
+
+/**
+ * Carves rooms connected by corridors. The inner area of the map is split recursively by a binary
+ * space partition, every leaf gets a room and the rooms of sibling partitions are connected,
+ * so all rooms are reachable. Finally, the entry is connected to one of the rooms.
+ *
+ * @param map The map to carve, all tiles must be walls and the entry position must be set.
+ */
+void carve_rooms(map_t* map);
+
+#endif//MAP_ROOM_GENERATOR_H
@@ -3,6 +3,9 @@
 #include "../helper/string_helper.h"
 #include "../logger/logger.h"
 #include "character/character_save_handler.h"
+#include "map/map_chunks.h"
+#include "map/map_compression.h"
+#include "map/map_revealer.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -29,6 +32,9 @@
     }
 
 #define SAVE_FILE_DIR "save_files"
+#define SAVE_TILE_BLOCK 1024// revealed tiles are converted from / to the revealed mask in blocks of this size
+
+static char save_file_dir[200] = SAVE_FILE_DIR;// directory of the save files, see set_save_directory
 
 static struct {
     save_slot_t slot;
@@ -57,41 +63,66 @@ int save_file_checks(const char* save_name);
 int ensure_save_dir(void);
 
 /**
- * Calculates a checksum for the given game state to ensure data consistency.
+ * Calculates the checksum of a single map, the checksum of the game state is the sum of the checksums
+ * of all maps, the floor count, the active map index and the character.
  *
- * @param game_state A pointer to the game state structure to be processed.
+ * @param map A pointer to the map, which may be packed or chunked.
  * @return Returns the calculated checksum as a long value.
  */
-long calculate_checksum(const game_state_t* game_state);
+long calculate_map_checksum(const map_t* map);
 
 /**
- * Allocates memory for an array of maps and initializes their associated resources using
- * the provided memory pool.
+ * Writes the tiles of a map to the save file. Packed maps are written as plain tiles, the revealed
+ * tiles are read from the hidden tiles through the revealed mask.
  *
- * @param pool Pointer to the memory pool to be used for memory allocation.
- * @param maps Double pointer to an array of map_t structures to be allocated and initialized.
- * @param length The number of maps to allocate and initialize.
- * @return Returns 0 if memory allocation and initialization are successful, otherwise returns 1
- *         if an error occurs (e.g., failed memory allocation).
+ * @param file The save file.
+ * @param map The map to write.
+ * @return Returns 0 on success, 1 on failure.
+ */
+int write_map_tiles(FILE* file, const map_t* map);
+
+/**
+ * Returns a block of the hidden tiles of a map, the tiles of packed maps are decoded into the buffer.
+ * The blocks of packed maps must be requested in order, starting with a zero initialized cursor.
+ *
+ * @param map The map, which must not be chunked.
+ * @param cursor The position in the packed tiles, unused for maps which are not packed.
+ * @param start The index of the first tile of the block.
+ * @param count The number of tiles, at most SAVE_TILE_BLOCK.
+ * @param buffer Receives the decoded tiles of packed maps.
+ * @return The hidden tiles of the block, or NULL if the packed tiles are corrupted.
  */
-int allocate_maps(const memory_pool_t* pool, map_t** maps, int length);
+const map_tile_t* get_hidden_tile_block(const map_t* map, packed_tiles_cursor_t* cursor, int start, int count,
+                                        map_tile_t* buffer);
 
 /**
- * Sets the hidden_tiles and revealed_tiles pointers of all maps in the array to NULL.
+ * Reads the tiles of a map allocated with `allocate_map` from the save file.
  *
- * @param map An array of pointers to map_t structures, where the tile pointers should be initialized to NULL.
- * @param length The number of elements in the array.
+ * @param file The save file.
+ * @param map The map to fill.
+ * @return Returns 0 on success, 1 on failure.
  */
-void set_maps_tiles_null(map_t** map, int length);
+int read_map_tiles(FILE* file, const map_t* map);
 
 /**
- * Frees the allocated memory for an array of map structures and their associated resources.
+ * Allocates a map with the fixed integer values of the given header and the memory for its tiles
+ * (or its chunk directory) using the provided memory pool.
  *
- * @param pool The memory pool used to allocate the map resources.
- * @param map A double pointer to the array of map_t structures to be freed.
- * @param length The number of map_t structures in the array.
+ * @param pool Pointer to the memory pool to be used for memory allocation.
+ * @param header The map containing the values read from the save file.
+ * @return Returns the allocated map, or NULL if an allocation failed.
+ */
+map_t* allocate_map(const memory_pool_t* pool, const map_t* header);
+
+/**
+ * Frees everything allocated so far by a failed `load_game_state` and closes the save file.
+ *
+ * @param pool The memory pool used for the allocations.
+ * @param game_state The game state, whose floor cache is cleared.
+ * @param headers The temporary map headers.
+ * @param file The save file.
  */
-void free_map_resources(const memory_pool_t* pool, map_t** map, int length);
+void load_cleanup(const memory_pool_t* pool, const game_state_t* game_state, map_t* headers, FILE* file);
 
 int save_game_state(const save_slot_t save_slot, const game_state_t* game_state) {
     RETURN_WHEN_TRUE(save_slot < 0 || save_slot >= MAX_SAVE_SLOTS, 1,
@@ -102,7 +133,7 @@ int save_game_state(const save_slot_t save_slot, const game_state_t* game_state)
     if (save_file_checks(save_name) != 0) return 1;
 
     char save_file_path[256];
-    snprintf(save_file_path, sizeof(save_file_path), "%s%s%s", SAVE_FILE_DIR, PATH_SEP, save_name);
+    snprintf(save_file_path, sizeof(save_file_path), "%s%s%s", save_file_dir, PATH_SEP, save_name);
 
     FILE* file = fopen(save_file_path, "wb");
     RETURN_WHEN_NULL(file, 1, "Save File Handler", "Failed to open save file for writing")
@@ -118,25 +149,31 @@ int save_game_state(const save_slot_t save_slot, const game_state_t* game_state)
 
     // first write all the fixed integer values of each map
     for (int i = 0; i < game_state->max_floors; i++) {
-        RETURN_WHEN_NULL(game_state->maps[i], 1, "Save File Handler", "In `save_game_state` given map %d is NULL", i)
+        int is_copy;
+        map_t* map = peek_floor(game_state->floors, i, &is_copy);
+        RETURN_WHEN_NULL_CLEAN(map, 1, fclose(file), "Save File Handler", "In `save_game_state` given map %d is NULL", i)
         // write floor_nr, width, height, enemy_count, exit_unlocked,
         // entry_pos.dx, entry_pos.dy, exit_pos.dx, exit_pos.dy,
         // player_pos.dx and player_pos.dy
-        fwrite(&game_state->maps[i]->floor_nr, sizeof(int), 11, file);
+        fwrite(&map->floor_nr, sizeof(int), 11, file);
+        release_floor(game_state->floors, map, is_copy);
     }
-    // then write the tiles of each map
+    long checksum = game_state->max_floors + game_state->active_map_index;
+    // then write the tiles of each map, evicted floors are read back one at a time
     for (int i = 0; i < game_state->max_floors; i++) {
-        const int map_size = game_state->maps[i]->width * game_state->maps[i]->height;
-        // write the hidden tiles
-        fwrite(game_state->maps[i]->hidden_tiles, sizeof(map_tile_t), map_size, file);
-        // write the revealed tiles
-        fwrite(game_state->maps[i]->revealed_tiles, sizeof(map_tile_t), map_size, file);
+        int is_copy;
+        map_t* map = peek_floor(game_state->floors, i, &is_copy);
+        RETURN_WHEN_NULL_CLEAN(map, 1, fclose(file), "Save File Handler", "In `save_game_state` given map %d is NULL", i)
+        const int failed = write_map_tiles(file, map);
+        checksum += calculate_map_checksum(map);
+        release_floor(game_state->floors, map, is_copy);
+        RETURN_WHEN_TRUE_CLEAN(failed, 1, fclose(file), "Save File Handler", "Failed to write the tiles of map %d", i)
     }
 
     // write character data
     write_character_data(file, game_state->player);
 
-    const long checksum = calculate_checksum(game_state);
+    checksum += calculate_checksum_c(game_state->player);
     fwrite(&checksum, sizeof(long), 1, file);
 
     fclose(file);
@@ -154,7 +191,7 @@ int load_game_state(const save_slot_t save_slot, const memory_pool_t* pool, game
     if (save_file_checks(save_name) != 0) return 1;
 
     char save_file_path[256];
-    snprintf(save_file_path, sizeof(save_file_path), "%s%s%s", SAVE_FILE_DIR, PATH_SEP, save_name);
+    snprintf(save_file_path, sizeof(save_file_path), "%s%s%s", save_file_dir, PATH_SEP, save_name);
 
     FILE* file = fopen(save_file_path, "rb");
     RETURN_WHEN_NULL(file, 1, "Save File Handler", "Failed to open save file for writing")
@@ -167,43 +204,56 @@ int load_game_state(const save_slot_t save_slot, const memory_pool_t* pool, game
 
     // reading the max floors and active map index from file
     FREAD(&game_state->max_floors, sizeof(int), 2, file, 1)
-    // reading all the fixed integer values of each map
-    for (int i = 0; i < game_state->max_floors; i++) {
-        if (game_state->maps[i] != NULL) {
-            log_msg(WARNING, "Save File Handler",
-                    "Map %d is not NULL, the map pointer will be overwritten with a new allocated pointer.", i);
-        }
-
-        // allocate memory for the map
-        game_state->maps[i] = memory_pool_alloc(pool, sizeof(map_t));
+    RETURN_WHEN_TRUE_CLEAN(game_state->max_floors < 0, 1, fclose(file), "Save File Handler",
+                           "Invalid number of floors %d", game_state->max_floors)
 
+    // reading all the fixed integer values of each map, the tiles follow after all of them
+    map_t* headers = memory_pool_alloc(pool, (game_state->max_floors + 1) * sizeof(map_t));
+    RETURN_WHEN_NULL_CLEAN(headers, 1, fclose(file), "Save File Handler", "Failed to allocate memory for map headers")
+    for (int i = 0; i < game_state->max_floors; i++) {
         // read floor_nr, width, height, enemy_count, exit_unlocked,
         // entry_pos.dx, entry_pos.dy, exit_pos.dx, exit_pos.dy,
         // player_pos.dx and player_pos.dy
-        FREAD(&game_state->maps[i]->floor_nr, sizeof(int), 11, file, 1)
+        RETURN_WHEN_TRUE_CLEAN(fread(&headers[i].floor_nr, sizeof(int), 11, file) != 11, 1,
+                               memory_pool_free(pool, headers); fclose(file),
+                               "Save File Handler", "Failed to read from save file")
     }
-    // allocate all the maps in the memory pool
-    RETURN_WHEN_TRUE(allocate_maps(pool, game_state->maps, game_state->max_floors) != 0, 1,
-                     "Save File Handler", "Failed to allocate memory for maps")
 
-    // reading all the tiles of each map
+    // reading the tiles of each map, the floors are added to the cache one by one, so only a few are in memory
+    clear_floor_cache(game_state->floors);
+    long checksum = game_state->max_floors + game_state->active_map_index;
     for (int i = 0; i < game_state->max_floors; i++) {
-        const int width = game_state->maps[i]->width;
-        const int height = game_state->maps[i]->height;
-        const int map_size = width * height;
+        map_t* map = allocate_map(pool, &headers[i]);
+        RETURN_WHEN_NULL_CLEAN(map, 1, load_cleanup(pool, game_state, headers, file),
+                               "Save File Handler", "Failed to allocate memory for map %d", i)
+        if (read_map_tiles(file, map) != 0) {
+            destroy_map(pool, map);
+            load_cleanup(pool, game_state, headers, file);
+            log_msg(ERROR, "Save File Handler", "Failed to read the tiles of map %d", i);
+            return 1;
+        }
+        checksum += calculate_map_checksum(map);
 
-        // read the hidden tiles
-        if (fread(game_state->maps[i]->hidden_tiles, sizeof(map_tile_t), map_size, file) != map_size) {
-            free_map_resources(pool, game_state->maps, game_state->max_floors);
-            fclose(file);
-            log_msg(ERROR, "Save File Handler", "Failed to read hidden tiles");
+        // only the active floor is kept unpacked
+        if (i != game_state->active_map_index && pack_map(pool, map) != 0) {
+            log_msg(WARNING, "Save File Handler", "Failed to pack map %d", i);
+        }
+        if (add_floor(game_state->floors, map) != i) {
+            destroy_map(pool, map);
+            load_cleanup(pool, game_state, headers, file);
+            log_msg(ERROR, "Save File Handler", "Failed to add map %d to the floor cache", i);
             return 1;
         }
-        // read the revealed tiles
-        if (fread(game_state->maps[i]->revealed_tiles, sizeof(map_tile_t), map_size, file) != map_size) {
-            free_map_resources(pool, game_state->maps, game_state->max_floors);
+    }
+    memory_pool_free(pool, headers);
+
+    // the later floors may have evicted the active floor, so it is paged in again and kept unpacked
+    if (game_state->active_map_index >= 0) {
+        map_t* active = get_floor(game_state->floors, game_state->active_map_index);
+        if (active == NULL || unpack_map(pool, active) != 0) {
+            clear_floor_cache(game_state->floors);
             fclose(file);
-            log_msg(ERROR, "Save File Handler", "Failed to read revealed tiles");
+            log_msg(ERROR, "Save File Handler", "Failed to restore the active map %d", game_state->active_map_index);
             return 1;
         }
     }
@@ -215,13 +265,13 @@ int load_game_state(const save_slot_t save_slot, const memory_pool_t* pool, game
     // malloc player
     game_state->player = create_empty_character(0);
     if (game_state->player == NULL) {
-        free_map_resources(pool, game_state->maps, game_state->max_floors);
+        clear_floor_cache(game_state->floors);
         fclose(file);
         return 1;
     }
     // read character data
     if (read_character_data(file, game_state->player) != 0) {
-        free_map_resources(pool, game_state->maps, game_state->max_floors);
+        clear_floor_cache(game_state->floors);
         fclose(file);
         return 1;
     }
@@ -231,12 +281,12 @@ int load_game_state(const save_slot_t save_slot, const memory_pool_t* pool, game
     if (fread(&file_checksum, sizeof(long), 1, file) != 1) {
         destroy_character(game_state->player);
         game_state->player = NULL;
-        free_map_resources(pool, game_state->maps, game_state->max_floors);
+        clear_floor_cache(game_state->floors);
         fclose(file);
         log_msg(ERROR, "Save File Handler", "Failed to read checksum");
         return 1;
     }
-    const long calculated_checksum = calculate_checksum(game_state);
+    const long calculated_checksum = checksum + calculate_checksum_c(game_state->player);
     if (calculated_checksum != file_checksum) {
         log_msg(ERROR, "Save File Handler",
                 "Checksum mismatch: expected %ld, got %ld", calculated_checksum, file_checksum);
@@ -246,6 +296,11 @@ int load_game_state(const save_slot_t save_slot, const memory_pool_t* pool, game
     return 0;
 }
 
+void set_save_directory(const char* directory) {
+    RETURN_WHEN_NULL(directory, , "Save File Handler", "Save directory is NULL")
+    snprintf(save_file_dir, sizeof(save_file_dir), "%s", directory);
+}
+
 save_infos_t get_save_infos(void) {
     // ensure the save directory exists
     const save_infos_t empty = {NULL, 0};
@@ -263,7 +318,7 @@ save_infos_t get_save_infos(void) {
     // go through each save file, if the save file exists, read the length & timestamp string
     for (int i = 0; i < MAX_SAVE_SLOTS; i++) {
         char save_file_path[1024];
-        snprintf(save_file_path, sizeof(save_file_path), "%s%s%s", SAVE_FILE_DIR, PATH_SEP,
+        snprintf(save_file_path, sizeof(save_file_path), "%s%s%s", save_file_dir, PATH_SEP,
                  save_slot_files[i].name);
 
         STAT_STRUCT st;
@@ -315,91 +370,138 @@ int save_file_checks(const char* save_name) {
 int ensure_save_dir(void) {
     STAT_STRUCT st;
 
-    if (STAT_FUNC(SAVE_FILE_DIR, &st) == -1) {
-        if (MKDIR(SAVE_FILE_DIR) == -1) {
+    if (STAT_FUNC(save_file_dir, &st) == -1) {
+        if (MKDIR(save_file_dir) == -1) {
             return 1;
         }
     }
     return 0;
 }
 
-long calculate_checksum(const game_state_t* game_state) {
+long calculate_map_checksum(const map_t* map) {
     long checksum = 0;
+    checksum += map->floor_nr;
+    checksum += map->width;
+    checksum += map->height;
+    checksum += map->enemy_count;
+    checksum += map->exit_unlocked;
+    checksum += map->entry_pos.dx;
+    checksum += map->entry_pos.dy;
+    checksum += map->exit_pos.dx;
+    checksum += map->exit_pos.dy;
+    checksum += map->player_pos.dx;
+    checksum += map->player_pos.dy;
+    if (map->chunks != NULL) {
+        return checksum + calculate_checksum_chunks(map->chunks);
+    }
 
-    checksum += game_state->max_floors;
-    checksum += game_state->active_map_index;
-
-    for (int i = 0; i < game_state->max_floors; i++) {
-        checksum += game_state->maps[i]->floor_nr;
-        checksum += game_state->maps[i]->width;
-        checksum += game_state->maps[i]->height;
-        checksum += game_state->maps[i]->enemy_count;
-        checksum += game_state->maps[i]->exit_unlocked;
-        checksum += game_state->maps[i]->entry_pos.dx;
-        checksum += game_state->maps[i]->entry_pos.dy;
-        checksum += game_state->maps[i]->exit_pos.dx;
-        checksum += game_state->maps[i]->exit_pos.dy;
-        checksum += game_state->maps[i]->player_pos.dx;
-        checksum += game_state->maps[i]->player_pos.dy;
-        for (int j = 0; j < game_state->maps[i]->width * game_state->maps[i]->height; j++) {
-            checksum += game_state->maps[i]->hidden_tiles[j];
-            checksum += game_state->maps[i]->revealed_tiles[j];
+    const int map_size = map->width * map->height;
+    packed_tiles_cursor_t cursor = {0};
+    map_tile_t unpacked_tiles[SAVE_TILE_BLOCK];
+    for (int start = 0; start < map_size; start += SAVE_TILE_BLOCK) {
+        const int count = map_size - start < SAVE_TILE_BLOCK ? map_size - start : SAVE_TILE_BLOCK;
+        const map_tile_t* hidden_tiles = get_hidden_tile_block(map, &cursor, start, count, unpacked_tiles);
+        if (hidden_tiles == NULL) return checksum;
+        for (int j = 0; j < count; j++) {
+            checksum += hidden_tiles[j];
+            checksum += IS_REVEALED(map->revealed_mask, start + j) ? hidden_tiles[j] : HIDDEN;
         }
     }
-
-    checksum += calculate_checksum_c(game_state->player);
-
     return checksum;
 }
 
-int allocate_maps(const memory_pool_t* pool, map_t** maps, const int length) {
-    if (maps == NULL) return 1;
-    if (pool == NULL) return 1;
-
-    // check if the maps are allocated
-    for (int i = 0; i < length; i++) {
-        if (maps[i] == NULL) {
-            log_msg(ERROR, "Save File Handler",
-                    "Maps are not allocated, probably failed to allocate in `load_game_state`");
-            for (int j = 0; j < length; j++) {
-                // free all the previously allocated maps
-                if (maps[j] != NULL) memory_pool_free(pool, maps[j]);
-            }
-            return 1;
-        }
+int write_map_tiles(FILE* file, const map_t* map) {
+    if (map->chunks != NULL) {
+        // chunked maps only write their generated chunks
+        return write_map_chunks(file, map->chunks);
     }
-    set_maps_tiles_null(maps, length);// pre-set all the tiles to NULL
-    // allocate the hidden and revealed tiles
-    for (int i = 0; i < length; i++) {
-        maps[i]->hidden_tiles = memory_pool_alloc(pool, sizeof(map_tile_t) * maps[i]->width * maps[i]->height);
-        maps[i]->revealed_tiles = memory_pool_alloc(pool, sizeof(map_tile_t) * maps[i]->width * maps[i]->height);
-
-        if (maps[i]->hidden_tiles == NULL || maps[i]->revealed_tiles == NULL) {
-            free_map_resources(pool, maps, i);
-            log_msg(ERROR, "Save File Handler", "Failed to allocate memory for map tiles");
-            return 1;
+    // inactive floors are packed in memory, the save file always stores the plain tiles
+    const int map_size = map->width * map->height;
+    map_tile_t unpacked_tiles[SAVE_TILE_BLOCK];
+    // write the hidden tiles
+    packed_tiles_cursor_t cursor = {0};
+    for (int start = 0; start < map_size; start += SAVE_TILE_BLOCK) {
+        const int count = map_size - start < SAVE_TILE_BLOCK ? map_size - start : SAVE_TILE_BLOCK;
+        const map_tile_t* hidden_tiles = get_hidden_tile_block(map, &cursor, start, count, unpacked_tiles);
+        if (hidden_tiles == NULL) return 1;
+        fwrite(hidden_tiles, sizeof(map_tile_t), count, file);
+    }
+    // write the revealed tiles, which are the hidden tiles read through the revealed mask
+    cursor = (packed_tiles_cursor_t) {0};
+    map_tile_t revealed_tiles[SAVE_TILE_BLOCK];
+    for (int start = 0; start < map_size; start += SAVE_TILE_BLOCK) {
+        const int count = map_size - start < SAVE_TILE_BLOCK ? map_size - start : SAVE_TILE_BLOCK;
+        const map_tile_t* hidden_tiles = get_hidden_tile_block(map, &cursor, start, count, unpacked_tiles);
+        if (hidden_tiles == NULL) return 1;
+        for (int j = 0; j < count; j++) {
+            revealed_tiles[j] = IS_REVEALED(map->revealed_mask, start + j) ? hidden_tiles[j] : HIDDEN;
         }
+        fwrite(revealed_tiles, sizeof(map_tile_t), count, file);
     }
     return 0;
 }
 
-void set_maps_tiles_null(map_t** map, const int length) {
-    if (map == NULL) return;
-    for (int i = 0; i < length; i++) {
-        if (map[i] != NULL) {
-            map[i]->hidden_tiles = NULL;
-            map[i]->revealed_tiles = NULL;
-        }
+const map_tile_t* get_hidden_tile_block(const map_t* map, packed_tiles_cursor_t* cursor, const int start,
+                                        const int count, map_tile_t* buffer) {
+    if (map->packed_tiles == NULL) return map->hidden_tiles + start;
+    return unpack_map_tiles(map, cursor, buffer, count) == 0 ? buffer : NULL;
+}
+
+int read_map_tiles(FILE* file, const map_t* map) {
+    if (map->chunks != NULL) {
+        return read_map_chunks(file, map->chunks);
+    }
+    const int map_size = map->width * map->height;
+    // read the hidden tiles
+    RETURN_WHEN_TRUE(fread(map->hidden_tiles, sizeof(map_tile_t), map_size, file) != map_size, 1,
+                     "Save File Handler", "Failed to read hidden tiles")
+    // read the revealed tiles, only whether a tile is revealed is kept
+    memset(map->revealed_mask, 0, MASK_WORDS(map_size) * sizeof(uint64_t));
+    map_tile_t revealed_tiles[SAVE_TILE_BLOCK];
+    for (int start = 0; start < map_size; start += SAVE_TILE_BLOCK) {
+        const int count = map_size - start < SAVE_TILE_BLOCK ? map_size - start : SAVE_TILE_BLOCK;
+        RETURN_WHEN_TRUE(fread(revealed_tiles, sizeof(map_tile_t), count, file) != count, 1,
+                         "Save File Handler", "Failed to read revealed tiles")
+        merge_revealed_tiles(revealed_tiles, start, count, map->revealed_mask);
     }
+    return 0;
 }
 
-void free_map_resources(const memory_pool_t* pool, map_t** map, const int length) {
-    if (map == NULL) return;
-    for (int i = 0; i < length; i++) {
-        if (map[i] != NULL) {
-            if (map[i]->hidden_tiles != NULL) memory_pool_free(pool, map[i]->hidden_tiles);
-            if (map[i]->revealed_tiles != NULL) memory_pool_free(pool, map[i]->revealed_tiles);
-            memory_pool_free(pool, map[i]);
-        }
+map_t* allocate_map(const memory_pool_t* pool, const map_t* header) {
+    map_t* map = memory_pool_alloc(pool, sizeof(map_t));
+    RETURN_WHEN_NULL(map, NULL, "Save File Handler", "Failed to allocate memory for map")
+    *map = *header;
+    map->hidden_tiles = NULL;
+    map->revealed_mask = NULL;
+    map->chunks = NULL;
+    map->packed_tiles = NULL;
+    map->packed_size = 0;
+    map->batch_owned = 0;
+    forget_lit_origins(map);
+    reset_reveal_events(map);
+    touch_map_tiles(map);
+
+    if (map_uses_chunks(map->width, map->height)) {
+        // the chunks themselves are allocated while reading
+        map->chunks = create_map_chunks(pool, map->width, map->height);
+        RETURN_WHEN_NULL_CLEAN(map->chunks, NULL, memory_pool_free(pool, map),
+                               "Save File Handler", "Failed to allocate memory for map chunks")
+        return map;
+    }
+    map->hidden_tiles = memory_pool_alloc(pool, sizeof(map_tile_t) * map->width * map->height);
+    map->revealed_mask = memory_pool_alloc(pool, sizeof(uint64_t) * MASK_WORDS(map->width * map->height));
+    if (map->hidden_tiles == NULL || map->revealed_mask == NULL) {
+        if (map->hidden_tiles != NULL) memory_pool_free(pool, map->hidden_tiles);
+        if (map->revealed_mask != NULL) memory_pool_free(pool, map->revealed_mask);
+        memory_pool_free(pool, map);
+        log_msg(ERROR, "Save File Handler", "Failed to allocate memory for map tiles");
+        return NULL;
     }
+    return map;
+}
+
+void load_cleanup(const memory_pool_t* pool, const game_state_t* game_state, map_t* headers, FILE* file) {
+    clear_floor_cache(game_state->floors);
+    memory_pool_free(pool, headers);
+    fclose(file);
 }
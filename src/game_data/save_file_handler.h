@@ -3,6 +3,7 @@
 
 #include "../memory/mem_mgmt.h"
 #include "character/character.h"
+#include "floor_cache.h"
 #include "map/map.h"
 
 typedef enum {
@@ -17,7 +18,7 @@ typedef enum {
 typedef struct {
     int max_floors;
     int active_map_index;
-    map_t** maps;
+    floor_cache_t* floors;// the floors of the dungeon, only the recently used ones are kept in memory
     Character* player;
 } game_state_t;
 
@@ -69,4 +70,12 @@ int load_game_state(save_slot_t save_slot, const memory_pool_t* pool, game_state
  */
 save_infos_t get_save_infos(void);
 
+/**
+ * Sets the directory the save files are written to and read from, it is created on the next save when missing.
+ * Defaults to "save_files" relative to the working directory, paths longer than 199 characters are truncated.
+ *
+ * @param directory The path of the save directory.
+ */
+void set_save_directory(const char* directory);
+
 #endif//SAVE_FILE_HANDLER_H
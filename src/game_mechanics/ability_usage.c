@@ -168,6 +168,7 @@ usage_result_t consume_resource(Character* user, const ability_t* ability) {
             res = UNEXPECTED_ERROR;// failed to use ability
             break;
     }
+    if (res == SUCCESS) touch_character_stats(user);
 
     return res;
 }
@@ -271,6 +272,7 @@ usage_result_t damage_target(Character* target, const char r_target, const int d
                     "Invalid resource target: %c encountered in `use_ability_on`", r_target);
             return UNEXPECTED_ERROR;
     }
+    touch_character_stats(target);
     return res;
 }
 
@@ -290,5 +292,6 @@ usage_result_t heal_target(Character* target, const char r_target, const int hea
                     "Invalid resource target: %c encountered in `use_ability_on`", r_target);
             return UNEXPECTED_ERROR;
     }
+    touch_character_stats(target);
     return SUCCESS;
 }
@@ -64,7 +64,7 @@ char* name_input_buffer = NULL;
 
 void update_cc_local(void);
 
-void update_stats(int bool_exp, int* updated_stats, int* unspent_points, int diff);
+void update_stats(Character* player, int bool_exp, int* updated_stats, int* unspent_points, int diff);
 
 void update_spent_p_str(int unspent_points);
 
@@ -99,6 +99,7 @@ state_t update_character_creation(const input_t input, Character* player) {
             player->id = 0;
             player->unspent_attr_p = UNSPENT_ATTR_POINTS;
             player->unspent_res_p = UNSPENT_RES_POINTS;
+            touch_character_stats(player);
             cc_state = NAME_INPUT;
             break;
         case NAME_INPUT:
@@ -124,6 +125,7 @@ state_t update_character_creation(const input_t input, Character* player) {
                 case ENTER:
                     if (name_input_buffer[0] != '\0') {
                         player->name = strdup(name_input_buffer);
+                        touch_character_stats(player);
                         end_text_input();
                         name_input_buffer = NULL;
 
@@ -142,27 +144,27 @@ state_t update_character_creation(const input_t input, Character* player) {
         case RESSOURCE_DISTRIBUTION:
             switch (spend_res_p_spinner->vtable->handle_menu(spend_res_p_spinner, input, 5, CC_Y_POS_BODY)) {
                 case 0:// decrease health by one
-                    update_stats(player->base_resources.health > 1,
+                    update_stats(player, player->base_resources.health > 1,
                                  &player->base_resources.health, &player->unspent_res_p, -1);
                     break;
                 case 1:// increase health by one
-                    update_stats(player->unspent_res_p > 0,
+                    update_stats(player, player->unspent_res_p > 0,
                                  &player->base_resources.health, &player->unspent_res_p, 1);
                     break;
                 case 2:// decrease stamina by one
-                    update_stats(player->base_resources.stamina > 1,
+                    update_stats(player, player->base_resources.stamina > 1,
                                  &player->base_resources.stamina, &player->unspent_res_p, -1);
                     break;
                 case 3:// increase stamina by one
-                    update_stats(player->unspent_res_p > 0,
+                    update_stats(player, player->unspent_res_p > 0,
                                  &player->base_resources.stamina, &player->unspent_res_p, 1);
                     break;
                 case 4:// decrease mana by one
-                    update_stats(player->base_resources.mana > 1,
+                    update_stats(player, player->base_resources.mana > 1,
                                  &player->base_resources.mana, &player->unspent_res_p, -1);
                     break;
                 case 5:// increase mana by one
-                    update_stats(player->unspent_res_p > 0,
+                    update_stats(player, player->unspent_res_p > 0,
                                  &player->base_resources.mana, &player->unspent_res_p, 1);
                     break;
                 case MAX_RESOURCES * 2:// nothing was pressed, do nothing
@@ -191,6 +193,7 @@ state_t update_character_creation(const input_t input, Character* player) {
                     // copy the base resources to max & current resources
                     player->max_resources = player->base_resources;
                     player->current_resources = player->base_resources;
+                    touch_character_stats(player);
 
                     cc_state = ATTRIBUTE_DISTRIBUTION;
                     update_spent_p_str(player->unspent_attr_p);
@@ -205,43 +208,43 @@ state_t update_character_creation(const input_t input, Character* player) {
         case ATTRIBUTE_DISTRIBUTION:
             switch (spend_attr_p_spinner->vtable->handle_menu(spend_attr_p_spinner, input, 5, CC_Y_POS_BODY)) {
                 case 0:// decrease strength by one
-                    update_stats(player->base_attributes.strength > 1,
+                    update_stats(player, player->base_attributes.strength > 1,
                                  &player->base_attributes.strength, &player->unspent_attr_p, -1);
                     break;
                 case 1:// increase strength by one
-                    update_stats(player->unspent_attr_p > 0,
+                    update_stats(player, player->unspent_attr_p > 0,
                                  &player->base_attributes.strength, &player->unspent_attr_p, 1);
                     break;
                 case 2:// decrease intelligence by one
-                    update_stats(player->base_attributes.intelligence > 1,
+                    update_stats(player, player->base_attributes.intelligence > 1,
                                  &player->base_attributes.intelligence, &player->unspent_attr_p, -1);
                     break;
                 case 3:// increase intelligence by one
-                    update_stats(player->unspent_attr_p > 0,
+                    update_stats(player, player->unspent_attr_p > 0,
                                  &player->base_attributes.intelligence, &player->unspent_attr_p, 1);
                     break;
                 case 4:// decrease agility by one
-                    update_stats(player->base_attributes.agility > 1,
+                    update_stats(player, player->base_attributes.agility > 1,
                                  &player->base_attributes.agility, &player->unspent_attr_p, -1);
                     break;
                 case 5:// increase agility by one
-                    update_stats(player->unspent_attr_p > 0,
+                    update_stats(player, player->unspent_attr_p > 0,
                                  &player->base_attributes.agility, &player->unspent_attr_p, 1);
                     break;
                 case 6:// decrease endurance by one
-                    update_stats(player->base_attributes.constitution > 1,
+                    update_stats(player, player->base_attributes.constitution > 1,
                                  &player->base_attributes.constitution, &player->unspent_attr_p, -1);
                     break;
                 case 7:// increase endurance by one
-                    update_stats(player->unspent_attr_p > 0,
+                    update_stats(player, player->unspent_attr_p > 0,
                                  &player->base_attributes.constitution, &player->unspent_attr_p, 1);
                     break;
                 case 8:// decrease luck by one
-                    update_stats(player->base_attributes.luck > 1,
+                    update_stats(player, player->base_attributes.luck > 1,
                                  &player->base_attributes.luck, &player->unspent_attr_p, -1);
                     break;
                 case 9:// increase luck by one
-                    update_stats(player->unspent_attr_p > 0,
+                    update_stats(player, player->unspent_attr_p > 0,
                                  &player->base_attributes.luck, &player->unspent_attr_p, 1);
                     break;
                 case MAX_ATTRIBUTES * 2:// nothing was pressed, do nothing
@@ -270,6 +273,7 @@ state_t update_character_creation(const input_t input, Character* player) {
                     // copy the base resources to max & current resources
                     player->max_attributes = player->base_attributes;
                     player->current_attributes = player->base_attributes;
+                    touch_character_stats(player);
 
                     cc_state = WAIT_AFTER_CREATION;
                     spend_attr_p_spinner->selected_index = 0;
@@ -342,11 +346,12 @@ void update_cc_local(void) {
     cc_mode_strings[CONFIRM_Y] = get_local_string("PRESS_Y.CONFIRM");
 }
 
-void update_stats(const int bool_exp, int* updated_stats, int* unspent_points, const int diff) {
+void update_stats(Character* player, const int bool_exp, int* updated_stats, int* unspent_points, const int diff) {
     if (bool_exp) {
         *updated_stats += diff;
         *unspent_points -= diff;
         update_spent_p_str(*unspent_points);
+        touch_character_stats(player);
     }
 }
 
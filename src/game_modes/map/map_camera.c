@@ -0,0 +1,34 @@
+#include "map_camera.h"
+
+/**
+ * Moves one coordinate of the window so the player position lies within the margin.
+ *
+ * @param start The first map coordinate of the window.
+ * @param size The size of the window.
+ * @param player The player coordinate.
+ * @param map_size The size of the map.
+ * @return The new first coordinate of the window.
+ */
+int follow_axis(int start, int size, int player, int map_size);
+
+void resize_map_camera(map_camera_t* camera, const map_t* map, const int max_width, const int max_height) {
+    camera->width = map->width < max_width ? map->width : max_width;
+    camera->height = map->height < max_height ? map->height : max_height;
+    if (camera->width < 1) camera->width = 1;
+    if (camera->height < 1) camera->height = 1;
+}
+
+void follow_player(map_camera_t* camera, const map_t* map) {
+    camera->x = follow_axis(camera->x, camera->width, map->player_pos.dx, map->width);
+    camera->y = follow_axis(camera->y, camera->height, map->player_pos.dy, map->height);
+}
+
+int follow_axis(int start, const int size, const int player, const int map_size) {
+    const int margin = size / 4;
+    if (player < start + margin) start = player - margin;
+    if (player > start + size - 1 - margin) start = player - size + 1 + margin;
+
+    if (start > map_size - size) start = map_size - size;
+    if (start < 0) start = 0;
+    return start;
+}
@@ -0,0 +1,36 @@
+#ifndef MAP_CAMERA_H
+#define MAP_CAMERA_H
+
+#include "../../game_data/map/map.h"
+
+/**
+ * The window of the map that is shown on the screen. Only the tiles inside the window are rendered,
+ * so the render cost depends on the terminal size and not on the map size.
+ */
+typedef struct {
+    int x;     // map position of the top left tile of the window
+    int y;
+    int width; // dimensions of the window, never larger than the map
+    int height;
+} map_camera_t;
+
+/**
+ * Fits the window into the given space and the map. The position is corrected by the next `follow_player`.
+ *
+ * @param camera The camera.
+ * @param map The shown map.
+ * @param max_width The number of columns available on the screen.
+ * @param max_height The number of rows available on the screen.
+ */
+void resize_map_camera(map_camera_t* camera, const map_t* map, int max_width, int max_height);
+
+/**
+ * Moves the window so the player keeps a margin of a quarter of the window to its borders. Inside that
+ * area the window stands still, so most steps don't scroll the view. The window never leaves the map.
+ *
+ * @param camera The camera, sized with `resize_map_camera`.
+ * @param map The shown map with the player position.
+ */
+void follow_player(map_camera_t* camera, const map_t* map);
+
+#endif//MAP_CAMERA_H
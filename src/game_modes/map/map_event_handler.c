@@ -2,14 +2,15 @@
 
 #include "../../logger/logger.h"
 
-void handle_fountain_event(const map_t* map, void (*reset_func)(Character*), Character* player);
+void handle_fountain_event(map_t* map, void (*reset_func)(Character*), Character* player);
 
 state_t handle_map_event(map_t* map, Character* player) {
     RETURN_WHEN_NULL(map, MAP_MODE, "Map Event Handler", "Map is NULL")
     RETURN_WHEN_NULL(player, MAP_MODE, "Map Event Handler", "Player is NULL")
 
-    const int player_on_map_idx = map->player_pos.dx * map->height + map->player_pos.dy;
-    const map_tile_t tile = map->hidden_tiles[player_on_map_idx];
+    const int player_x = map->player_pos.dx;
+    const int player_y = map->player_pos.dy;
+    const map_tile_t tile = get_hidden_tile(map, player_x, player_y);
 
     state_t next_state = MAP_MODE;
     switch (tile) {
@@ -27,8 +28,7 @@ state_t handle_map_event(map_t* map, Character* player) {
             break;
         case DOOR_KEY:
             player->has_map_key = 1;
-            map->hidden_tiles[player_on_map_idx] = FLOOR;
-            map->revealed_tiles[player_on_map_idx] = FLOOR;
+            set_hidden_tile(map, player_x, player_y, FLOOR);
             break;
         case LIFE_FOUNTAIN:
             handle_fountain_event(map, player->vtable->reset_health, player);
@@ -41,8 +41,7 @@ state_t handle_map_event(map_t* map, Character* player) {
             break;
         case ENEMY:
             next_state = GENERATE_ENEMY;
-            map->hidden_tiles[player_on_map_idx] = FLOOR;
-            map->revealed_tiles[player_on_map_idx] = FLOOR;
+            set_hidden_tile(map, player_x, player_y, FLOOR);
             break;
         default:
             // do nothing
@@ -51,10 +50,7 @@ state_t handle_map_event(map_t* map, Character* player) {
     return next_state;
 }
 
-void handle_fountain_event(const map_t* map, void (*reset_func)(Character*), Character* player) {
-    const int player_on_map_idx = map->player_pos.dx * map->height + map->player_pos.dy;
-
+void handle_fountain_event(map_t* map, void (*reset_func)(Character*), Character* player) {
     reset_func(player);
-    map->hidden_tiles[player_on_map_idx] = FLOOR;
-    map->revealed_tiles[player_on_map_idx] = FLOOR;
+    set_hidden_tile(map, map->player_pos.dx, map->player_pos.dy, FLOOR);
 }
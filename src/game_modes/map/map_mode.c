@@ -1,14 +1,24 @@
 #include "map_mode.h"
 
-#include "../../game_data/map/map_parser.h"
+#include "../../game_data/map/map_pathfinder.h"
 #include "../../game_data/map/map_revealer.h"
 #include "../../io/local/local_handler.h"
 #include "../../io/output/common/common_output.h"
+#include "../../io/output/frame/frame_buffer.h"
 #include "../../io/output/specific/character_output.h"
 #include "../../io/output/specific/map_output.h"
+#include "../../io/output/specific/minimap_output.h"
 #include "../../logger/logger.h"
+#include "map_camera.h"
 #include "map_event_handler.h"
 
+#define MAP_ANCHOR_X 5
+#define MAP_ANCHOR_Y 4
+#define PANEL_WIDTH 26// columns right of the map reserved for the character panel
+#define MIN_VIEW_SIZE 11
+#define MINIMAP_OFFSET_Y 11// rows below the top of the character panel
+#define MIN_MINIMAP_HEIGHT 3
+
 enum map_mode_index {
     GAME_TITLE,
     MAX_MAP_MODE_INDEX
@@ -16,8 +26,23 @@ enum map_mode_index {
 
 char** map_mode_strings = NULL;
 
+map_render_cache_t* map_render_cache = NULL;
+minimap_t* map_minimap = NULL;
+unsigned int drawn_stats_version = 0;// stats version of the player when the character panel was drawn
+map_camera_t map_camera = {0, 0, 0, 0};
+pathfinder_t* map_mode_pathfinder = NULL;// created with the first auto walk
+int auto_walk = 0;                       // 1 while the player walks to the revealed exit on its own
+
 void update_map_mode_local(void);
 
+/**
+ * Moves the player one step along the shortest path over revealed tiles to the exit door.
+ * Stops the auto walk when the exit isn't revealed yet or can't be reached over revealed tiles.
+ *
+ * @param map The current map.
+ */
+void auto_walk_step(map_t* map);
+
 int init_map_mode() {
     // allocate memory for the local strings
     map_mode_strings = (char**) malloc(sizeof(char*) * MAX_MAP_MODE_INDEX);
@@ -27,6 +52,11 @@ int init_map_mode() {
         map_mode_strings[i] = NULL;
     }
 
+    map_render_cache = create_map_render_cache();
+    RETURN_WHEN_NULL(map_render_cache, 1, "Map Mode", "Failed to create the map render cache.")
+    map_minimap = create_minimap();
+    RETURN_WHEN_NULL(map_minimap, 1, "Map Mode", "Failed to create the minimap.")
+
     update_map_mode_local();
     observe_local(update_map_mode_local);
     return 0;
@@ -35,41 +65,72 @@ int init_map_mode() {
 state_t update_map_mode(const input_t input, map_t* map, Character* player) {
     state_t next_state = MAP_MODE;
 
-    const int player_on_map_idx = map->player_pos.dx * map->height + map->player_pos.dy;
-
-    parsed_map_t* parsed_map = create_parsed_map(map->width, map->height, map->revealed_tiles, map->player_pos);
-    RETURN_WHEN_NULL(parsed_map, EXIT_GAME, "Map Mode", "Failed to parse map")
+    const int player_x = map->player_pos.dx;
+    const int player_y = map->player_pos.dy;
+
+    // the view fills the terminal next to the character panel and follows the player
+    int max_width = get_frame_width() - MAP_ANCHOR_X - PANEL_WIDTH;
+    int max_height = get_frame_height() - MAP_ANCHOR_Y - 1;
+    if (max_width < MIN_VIEW_SIZE) max_width = MIN_VIEW_SIZE;
+    if (max_height < MIN_VIEW_SIZE) max_height = MIN_VIEW_SIZE;
+    const int previous_width = map_camera.width;
+    resize_map_camera(&map_camera, map, max_width, max_height);
+    follow_player(&map_camera, map);
+    if (map_camera.width != previous_width) {
+        //the character panel moves with the right border of the view
+        invalidate_map_render_cache(map_render_cache);
+        invalidate_minimap(map_minimap);
+        clear_screen();
+    }
 
-    print_text(5, 2, RED, DEFAULT, map_mode_strings[GAME_TITLE]);
-    print_map(5, 4, parsed_map);
+    //the title and the panel stay in the back buffer, so a static scene leaves the frame untouched
+    const int redraw = !map_render_cache->valid;
+    if (redraw) print_text(MAP_ANCHOR_X, 2, RED, DEFAULT, map_mode_strings[GAME_TITLE]);
+    RETURN_WHEN_TRUE(render_map_view(map_render_cache, MAP_ANCHOR_X, MAP_ANCHOR_Y, map, map_camera.x, map_camera.y,
+                                     map_camera.width, map_camera.height) == -1,
+                     EXIT_GAME, "Map Mode", "Failed to render the map")
 
     const output_args_c_t map_mode_args = {1, RES_CURR_MAX, ATTR_MAX};
-    print_char_v(5 + map->width + 2, 4, player, map_mode_args);
+    if (redraw || player->stats_version != drawn_stats_version) {
+        print_char_v(MAP_ANCHOR_X + map_camera.width + 2, MAP_ANCHOR_Y, player, map_mode_args);
+        drawn_stats_version = player->stats_version;
+    }
 
-    free(parsed_map->tiles);
-    free(parsed_map);
+    // a floor larger than the view gets an overview below the character panel
+    const int minimap_height = get_frame_height() - MAP_ANCHOR_Y - MINIMAP_OFFSET_Y - 1;
+    if ((map_camera.width < map->width || map_camera.height < map->height) && minimap_height >= MIN_MINIMAP_HEIGHT) {
+        RETURN_WHEN_TRUE(render_minimap(map_minimap, MAP_ANCHOR_X + map_camera.width + 2,
+                                        MAP_ANCHOR_Y + MINIMAP_OFFSET_Y, map, PANEL_WIDTH - 2, minimap_height) == -1,
+                         EXIT_GAME, "Map Mode", "Failed to render the minimap")
+    }
 
     switch (input) {
         case UP:
-            if (map->player_pos.dy > 0 && map->revealed_tiles[player_on_map_idx - 1] != WALL) {
+            if (player_y > 0 && get_revealed_tile(map, player_x, player_y - 1) != WALL) {
                 map->player_pos.dy--;
             }
             break;
         case DOWN:
-            if (map->player_pos.dy < map->height - 1 && map->revealed_tiles[player_on_map_idx + 1] != WALL) {
+            if (player_y < map->height - 1 && get_revealed_tile(map, player_x, player_y + 1) != WALL) {
                 map->player_pos.dy++;
             }
             break;
         case LEFT:
-            if (map->player_pos.dx > 0 && map->revealed_tiles[player_on_map_idx - map->height] != WALL) {
+            if (player_x > 0 && get_revealed_tile(map, player_x - 1, player_y) != WALL) {
                 map->player_pos.dx--;
             }
             break;
         case RIGHT:
-            if (map->player_pos.dx < map->width - 1 && map->revealed_tiles[player_on_map_idx + map->height] != WALL) {
+            if (player_x < map->width - 1 && get_revealed_tile(map, player_x + 1, player_y) != WALL) {
                 map->player_pos.dx++;
             }
             break;
+        case E:// walk to the exit, once it is revealed
+            auto_walk = !auto_walk;
+            break;
+        case NO_INPUT:
+            if (auto_walk) auto_walk_step(map);
+            break;
         case M:
         case ESCAPE:
             clear_screen();
@@ -87,16 +148,55 @@ state_t update_map_mode(const input_t input, map_t* map, Character* player) {
             //does nothing
             break;
     }
-    if (input == UP || input == DOWN || input == LEFT || input == RIGHT) {
-        reveal_map(map, 3);
+    if (next_state != MAP_MODE) {
+        invalidate_map_render_cache(map_render_cache);// the next mode draws over the map
+        invalidate_minimap(map_minimap);
+    }
+    if (input != E && input != NO_INPUT) {
+        auto_walk = 0;// any other input takes back control
+    }
+    if (map->player_pos.dx != player_x || map->player_pos.dy != player_y) {
+        const vector2d_t delta = {map->player_pos.dx - player_x, map->player_pos.dy - player_y};
+        reveal_map_step(map, delta, 3);
         next_state = handle_map_event(map, player);
-        if (next_state != MAP_MODE) clear_screen();
+        if (next_state != MAP_MODE) {
+            auto_walk = 0;
+            invalidate_map_render_cache(map_render_cache);
+            invalidate_minimap(map_minimap);
+            clear_screen();
+        }
     }
 
     return next_state;
 }
 
+void auto_walk_step(map_t* map) {
+    if (map_mode_pathfinder == NULL) {
+        map_mode_pathfinder = create_pathfinder(global_memory_pool);
+        RETURN_WHEN_NULL(map_mode_pathfinder, , "Map Mode", "Failed to create the pathfinder")
+    }
+
+    vector2d_t step;
+    if (!find_exit_step(map_mode_pathfinder, map, &step)) {
+        auto_walk = 0;
+        return;
+    }
+    map->player_pos = step;
+}
+
 void shutdown_map_mode() {
+    if (map_render_cache != NULL) {
+        destroy_map_render_cache(map_render_cache);
+        map_render_cache = NULL;
+    }
+    if (map_minimap != NULL) {
+        destroy_minimap(map_minimap);
+        map_minimap = NULL;
+    }
+    if (map_mode_pathfinder != NULL) {
+        destroy_pathfinder(map_mode_pathfinder);
+        map_mode_pathfinder = NULL;
+    }
     if (map_mode_strings == NULL) return;
 
     for (int i = 0; i < MAX_MAP_MODE_INDEX; i++) {
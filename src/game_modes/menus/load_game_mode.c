@@ -247,17 +247,14 @@ void update_load_game_local(void) {
 
 int check_game_state(const game_state_t* game_state) {
     RETURN_WHEN_NULL(game_state, 1, "Load Game Mode", "Game state is NULL.");
-    RETURN_WHEN_NULL(game_state->maps, 1, "Load Game Mode", "Game state maps are NULL.");
+    RETURN_WHEN_NULL(game_state->floors, 1, "Load Game Mode", "Game state floors are NULL.");
     RETURN_WHEN_NULL(game_state->player, 1, "Load Game Mode", "Game state player is NULL.");
     return 0;
 }
 
 void load_helper(const save_slot_t slot, const memory_pool_t* pool, game_state_t* game_state) {
     // destroy the previous maps
-    for (int i = 0; i < game_state->max_floors; i++) {
-        destroy_map(pool, game_state->maps[i]);
-        game_state->maps[i] = NULL;
-    }
+    clear_floor_cache(game_state->floors);
 
     // destroy previous stored character
     destroy_character(game_state->player);
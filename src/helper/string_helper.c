@@ -53,7 +53,13 @@ int parse_float(const char* str, float* out) {
 
 size_t str_iso_time(char* buffer, const size_t buffer_size) {
     const time_t now = time(NULL);
-    const struct tm* tm = localtime(&now);
+    // localtime returns a shared struct, the logger calls this from any thread
+    struct tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
 
-    return strftime(buffer, buffer_size, "%Y-%m-%d %H:%M:%S", tm);
+    return strftime(buffer, buffer_size, "%Y-%m-%d %H:%M:%S", &tm);
 }
@@ -0,0 +1,9 @@
+#include "time_helper.h"
+
+#include <time.h>
+
+long long monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
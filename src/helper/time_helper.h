@@ -0,0 +1,9 @@
+#ifndef TIME_HELPER_H
+#define TIME_HELPER_H
+
+/**
+ * @return The current time of the monotonic clock in nanoseconds.
+ */
+long long monotonic_ns(void);
+
+#endif//TIME_HELPER_H
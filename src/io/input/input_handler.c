@@ -1,12 +1,15 @@
 #include "input_handler.h"
 
 #include "../../../termbox2/termbox2.h"
+#include "../../helper/time_helper.h"
 #include "../../logger/logger.h"
 #include "../../thread/thread_handler.h"
 
 #define INPUT_BUFFER_SIZE 16
 
 input_t input_buffer[INPUT_BUFFER_SIZE];
+long long input_time_buffer[INPUT_BUFFER_SIZE];// the poll time of each buffered input
+long long last_input_time = 0;
 volatile int buffer_head = 0;
 volatile int buffer_tail = 0;
 
@@ -43,10 +46,15 @@ input_t get_next_input() {
     if (buffer_head == buffer_tail) return NO_INPUT;// no input available
 
     const input_t input = input_buffer[buffer_tail];
+    last_input_time = input_time_buffer[buffer_tail];
     buffer_tail = (buffer_tail + 1) % INPUT_BUFFER_SIZE;
     return input;
 }
 
+long long get_last_input_time(void) {
+    return last_input_time;
+}
+
 char* start_text_input(const size_t max_length) {
     RETURN_WHEN_TRUE(text_buffer != NULL, NULL, "Input Handler", "Text input is already active");
     text_buffer = malloc(max_length);
@@ -97,8 +105,12 @@ void input_handler_thread() {
                 input = I;
             else if (event.ch == 'c')
                 input = C;
+            else if (event.ch == 'e')
+                input = E;
             else if (event.ch == 'y' || event.ch == 'Y')
                 input = Y;
+            else if (event.key == TB_KEY_F3)
+                input = F3;
             else if (event.key == TB_KEY_BACKSPACE || event.key == TB_KEY_BACKSPACE2)
                 input = BACKSPACE;
             else if (event.key == TB_KEY_ENTER)
@@ -115,6 +127,7 @@ void input_handler_thread() {
                     buffer_tail = (buffer_tail + 1) % INPUT_BUFFER_SIZE;
                 }
                 input_buffer[buffer_head] = input;
+                input_time_buffer[buffer_head] = monotonic_ns();
                 buffer_head = (buffer_head + 1) % INPUT_BUFFER_SIZE;
             }
 
@@ -11,7 +11,9 @@ typedef enum {
     M,
     I,
     C,
+    E,
     Y,
+    F3,
     BACKSPACE,
     ENTER,
     ESCAPE,
@@ -32,6 +34,11 @@ void init_input_handler();
  */
 input_t get_next_input(void);
 
+/**
+ * @return The monotonic time in nanoseconds, at which the input last returned by `get_next_input` was polled.
+ */
+long long get_last_input_time(void);
+
 /**
  * Starts a text input session by allocating a buffer for user input data
  * with a specified maximum length. The function ensures no additional
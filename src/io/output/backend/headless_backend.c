@@ -0,0 +1,174 @@
+#include "headless_backend.h"
+
+#include "../../../logger/logger.h"
+
+#include <stdlib.h>
+
+#define CELL_PIXEL_WIDTH 6
+#define CELL_PIXEL_HEIGHT 12
+#define GLYPH_MARGIN_X 1
+#define GLYPH_MARGIN_Y 2
+#define COLOR_MASK 0xff// the color bits of the termbox attributes, without bold, underline, ...
+
+typedef struct {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+} pixel_t;
+
+// indexed by the termbox color, TB_DEFAULT to TB_WHITE
+static const pixel_t fg_palette[] = {
+        {192, 192, 192},
+        {0, 0, 0},
+        {205, 49, 49},
+        {13, 188, 121},
+        {229, 229, 16},
+        {36, 114, 200},
+        {188, 63, 188},
+        {17, 168, 205},
+        {229, 229, 229}};
+static const pixel_t bg_palette[] = {
+        {0, 0, 0},
+        {0, 0, 0},
+        {205, 49, 49},
+        {13, 188, 121},
+        {229, 229, 16},
+        {36, 114, 200},
+        {188, 63, 188},
+        {17, 168, 205},
+        {229, 229, 229}};
+
+int headless_width(const Output_Backend* self);
+
+int headless_height(const Output_Backend* self);
+
+/**
+ * Copies the frame into the screen grid.
+ *
+ * @param self Pointer to the headless backend.
+ * @param frame The frame to write.
+ */
+void headless_write_frame(Output_Backend* self, const frame_buffer_t* frame);
+
+/**
+ * Maps termbox attributes to a pixel of the given palette. Colors outside the palette are mapped to
+ * the default color.
+ *
+ * @param palette The foreground or background palette.
+ * @param attr The termbox attributes.
+ * @return The pixel color.
+ */
+pixel_t attr_to_pixel(const pixel_t* palette, uintattr_t attr);
+
+headless_backend_t* create_headless_backend(const int width, const int height) {
+    RETURN_WHEN_TRUE(width <= 0 || height <= 0, NULL, "Headless Backend", "Invalid screen size: %dx%d",
+                     width, height)
+
+    headless_backend_t* backend = malloc(sizeof(headless_backend_t));
+    RETURN_WHEN_NULL(backend, NULL, "Headless Backend", "Failed to allocate the backend")
+    backend->screen.cells = malloc(sizeof(frame_cell_t) * width * height);
+    RETURN_WHEN_NULL_CLEAN(backend->screen.cells, NULL, free(backend), "Headless Backend",
+                           "Failed to allocate the %dx%d screen", width, height)
+
+    backend->base = (Output_Backend) {
+            .name = "headless",
+            .width = headless_width,
+            .height = headless_height,
+            .write_frame = headless_write_frame};
+    backend->screen.width = width;
+    backend->screen.height = height;
+    backend->screen.capacity = width * height;
+    for (int i = 0; i < backend->screen.capacity; i++) {
+        backend->screen.cells[i] = (frame_cell_t) {' ', TB_DEFAULT, TB_DEFAULT};
+    }
+    backend->frames_written = 0;
+    return backend;
+}
+
+void destroy_headless_backend(headless_backend_t* backend) {
+    if (backend == NULL) return;
+    free(backend->screen.cells);
+    free(backend);
+}
+
+const frame_cell_t* get_headless_cell(const headless_backend_t* backend, const int x, const int y) {
+    if (backend == NULL || x < 0 || y < 0 || x >= backend->screen.width || y >= backend->screen.height) {
+        return NULL;
+    }
+    return &backend->screen.cells[y * backend->screen.width + x];
+}
+
+int dump_headless_text(const headless_backend_t* backend, FILE* file) {
+    RETURN_WHEN_NULL(backend, 1, "Headless Backend", "In `dump_headless_text` backend is NULL")
+    RETURN_WHEN_NULL(file, 1, "Headless Backend", "In `dump_headless_text` file is NULL")
+
+    for (int y = 0; y < backend->screen.height; y++) {
+        for (int x = 0; x < backend->screen.width; x++) {
+            char utf8[8];
+            const int length = tb_utf8_unicode_to_char(utf8, backend->screen.cells[y * backend->screen.width + x].ch);
+            if (fwrite(utf8, 1, length, file) != (size_t) length) return 1;
+        }
+        if (fputc('\n', file) == EOF) return 1;
+    }
+    return 0;
+}
+
+int dump_headless_ppm(const headless_backend_t* backend, FILE* file) {
+    RETURN_WHEN_NULL(backend, 1, "Headless Backend", "In `dump_headless_ppm` backend is NULL")
+    RETURN_WHEN_NULL(file, 1, "Headless Backend", "In `dump_headless_ppm` file is NULL")
+
+    const int width = backend->screen.width;
+    if (fprintf(file, "P6\n%d %d\n255\n", width * CELL_PIXEL_WIDTH,
+                backend->screen.height * CELL_PIXEL_HEIGHT) < 0) {
+        return 1;
+    }
+
+    pixel_t row[width * CELL_PIXEL_WIDTH];
+    for (int y = 0; y < backend->screen.height; y++) {
+        for (int py = 0; py < CELL_PIXEL_HEIGHT; py++) {
+            const int glyph_row = py >= GLYPH_MARGIN_Y && py < CELL_PIXEL_HEIGHT - GLYPH_MARGIN_Y;
+            for (int x = 0; x < width; x++) {
+                const frame_cell_t* cell = &backend->screen.cells[y * width + x];
+                const pixel_t bg = attr_to_pixel(bg_palette, cell->bg);
+                const pixel_t fg = attr_to_pixel(fg_palette, cell->fg);
+                const int has_glyph = glyph_row && cell->ch != ' ' && cell->ch != 0;
+
+                for (int px = 0; px < CELL_PIXEL_WIDTH; px++) {
+                    const int glyph = has_glyph && px >= GLYPH_MARGIN_X && px < CELL_PIXEL_WIDTH - GLYPH_MARGIN_X;
+                    row[x * CELL_PIXEL_WIDTH + px] = glyph ? fg : bg;
+                }
+            }
+            if (fwrite(row, sizeof(pixel_t), width * CELL_PIXEL_WIDTH, file) != (size_t) width * CELL_PIXEL_WIDTH) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int headless_width(const Output_Backend* self) {
+    return ((const headless_backend_t*) self)->screen.width;
+}
+
+int headless_height(const Output_Backend* self) {
+    return ((const headless_backend_t*) self)->screen.height;
+}
+
+void headless_write_frame(Output_Backend* self, const frame_buffer_t* frame) {
+    headless_backend_t* backend = (headless_backend_t*) self;
+    frame_buffer_t* screen = &backend->screen;
+
+    for (int y = 0; y < screen->height; y++) {
+        for (int x = 0; x < screen->width; x++) {
+            screen->cells[y * screen->width + x] = x < frame->width && y < frame->height
+                                                           ? frame->cells[y * frame->width + x]
+                                                           : (frame_cell_t) {' ', TB_DEFAULT, TB_DEFAULT};
+        }
+    }
+    backend->frames_written++;
+}
+
+pixel_t attr_to_pixel(const pixel_t* palette, const uintattr_t attr) {
+    const uintattr_t color = attr & COLOR_MASK;
+    return color <= TB_WHITE ? palette[color] : palette[TB_DEFAULT];
+}
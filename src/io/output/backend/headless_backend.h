@@ -0,0 +1,64 @@
+#ifndef HEADLESS_BACKEND_H
+#define HEADLESS_BACKEND_H
+
+#include "output_backend.h"
+
+#include <stdio.h>
+
+/**
+ * A backend without a terminal, the frames are written into an in-memory cell grid. Used to measure and
+ * test the output functions, the grid can be dumped as text or as a PPM image.
+ */
+typedef struct {
+    Output_Backend base;// must be the first member, so the backend can be used as an `Output_Backend`
+    frame_buffer_t screen;
+    int frames_written;
+} headless_backend_t;
+
+/**
+ * Creates a headless backend with a blank screen of the given size.
+ *
+ * @param width The width of the screen in cells.
+ * @param height The height of the screen in cells.
+ * @return The backend, or NULL if the allocation failed.
+ */
+headless_backend_t* create_headless_backend(int width, int height);
+
+/**
+ * Frees the headless backend, it must not be the active backend anymore.
+ *
+ * @param backend The backend to destroy.
+ */
+void destroy_headless_backend(headless_backend_t* backend);
+
+/**
+ * Returns a cell of the screen.
+ *
+ * @param backend The headless backend.
+ * @param x The x-coordinate of the cell.
+ * @param y The y-coordinate of the cell.
+ * @return The cell, or NULL if the coordinates are outside the screen.
+ */
+const frame_cell_t* get_headless_cell(const headless_backend_t* backend, int x, int y);
+
+/**
+ * Writes the characters of the screen as utf-8 text, one line per row. Trailing blanks are kept,
+ * so every line has the width of the screen.
+ *
+ * @param backend The headless backend.
+ * @param file The file to write to.
+ * @return 0 on success, 1 on failure.
+ */
+int dump_headless_text(const headless_backend_t* backend, FILE* file);
+
+/**
+ * Writes the screen as a binary PPM image. Every cell is a block filled with its background color,
+ * non-blank cells get a smaller block with their foreground color in the middle.
+ *
+ * @param backend The headless backend.
+ * @param file The file to write to.
+ * @return 0 on success, 1 on failure.
+ */
+int dump_headless_ppm(const headless_backend_t* backend, FILE* file);
+
+#endif//HEADLESS_BACKEND_H
@@ -0,0 +1,13 @@
+#include "output_backend.h"
+
+#include "termbox_backend.h"
+
+Output_Backend* active_backend = NULL;// NULL means the termbox backend
+
+void set_output_backend(Output_Backend* backend) {
+    active_backend = backend;
+}
+
+Output_Backend* get_output_backend(void) {
+    return active_backend == NULL ? get_termbox_backend() : active_backend;
+}
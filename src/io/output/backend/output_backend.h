@@ -0,0 +1,46 @@
+#ifndef OUTPUT_BACKEND_H
+#define OUTPUT_BACKEND_H
+
+#include "../frame/frame_buffer.h"
+
+typedef struct Output_Backend Output_Backend;
+
+/**
+ * The target the finished frames are written to. Only the render thread, or the game logic when no render
+ * thread is running, calls the backend.
+ */
+struct Output_Backend {
+    const char* name;
+    /**
+     * @param self Pointer to the backend.
+     * @return The width of the screen in cells.
+     */
+    int (*width)(const Output_Backend* self);
+    /**
+     * @param self Pointer to the backend.
+     * @return The height of the screen in cells.
+     */
+    int (*height)(const Output_Backend* self);
+    /**
+     * Writes a whole frame to the screen. Cells outside the screen are dropped, screen cells outside
+     * the frame are blank.
+     *
+     * @param self Pointer to the backend.
+     * @param frame The frame to write.
+     */
+    void (*write_frame)(Output_Backend* self, const frame_buffer_t* frame);
+};
+
+/**
+ * Sets the backend the frames are written to. Must not be changed while the render thread runs.
+ *
+ * @param backend The new backend, NULL restores the termbox backend.
+ */
+void set_output_backend(Output_Backend* backend);
+
+/**
+ * @return The backend the frames are written to, the termbox backend by default.
+ */
+Output_Backend* get_output_backend(void);
+
+#endif//OUTPUT_BACKEND_H
@@ -0,0 +1,48 @@
+#include "termbox_backend.h"
+
+int termbox_width(const Output_Backend* self);
+
+int termbox_height(const Output_Backend* self);
+
+/**
+ * Writes the frame into the termbox back buffer and presents it, termbox only sends the changed cells.
+ *
+ * @param self Pointer to the backend.
+ * @param frame The frame to write.
+ */
+void termbox_write_frame(Output_Backend* self, const frame_buffer_t* frame);
+
+Output_Backend termbox_backend = {
+        .name = "termbox",
+        .width = termbox_width,
+        .height = termbox_height,
+        .write_frame = termbox_write_frame};
+
+Output_Backend* get_termbox_backend(void) {
+    return &termbox_backend;
+}
+
+int termbox_width(const Output_Backend* self) {
+    (void) self;
+    return tb_width();
+}
+
+int termbox_height(const Output_Backend* self) {
+    (void) self;
+    return tb_height();
+}
+
+void termbox_write_frame(Output_Backend* self, const frame_buffer_t* frame) {
+    (void) self;
+    const int width = frame->width < tb_width() ? frame->width : tb_width();
+    const int height = frame->height < tb_height() ? frame->height : tb_height();
+
+    tb_clear();
+    for (int y = 0; y < height; y++) {
+        const frame_cell_t* row = &frame->cells[y * frame->width];
+        for (int x = 0; x < width; x++) {
+            tb_set_cell(x, y, row[x].ch, row[x].fg, row[x].bg);
+        }
+    }
+    tb_present();
+}
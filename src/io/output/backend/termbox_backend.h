@@ -0,0 +1,11 @@
+#ifndef TERMBOX_BACKEND_H
+#define TERMBOX_BACKEND_H
+
+#include "output_backend.h"
+
+/**
+ * @return The backend writing the frames to the terminal with termbox, termbox must be initialized.
+ */
+Output_Backend* get_termbox_backend(void);
+
+#endif//TERMBOX_BACKEND_H
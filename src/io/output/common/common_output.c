@@ -1,7 +1,11 @@
 #include "common_output.h"
 
-#include "../../../../termbox2/termbox2.h"
 #include "../../../logger/logger.h"
+#include "../frame/frame_buffer.h"
+#include "../frame/render_thread.h"
+
+int frame_active = 0;// 1 between `begin_frame` and `end_frame`
+int frame_dirty = 0; // 1 if the back buffer changed during the frame
 
 /**
  * Ensures the provided coordinates are valid. If `x` or `y` are less than 0,
@@ -12,22 +16,50 @@
  */
 void check_xy(int* x, int* y);
 
+void begin_frame(void) {
+    frame_active = 1;
+    frame_dirty = 0;
+
+    // follow the terminal size reported by the render thread
+    const int width = get_screen_width();
+    const int height = get_screen_height();
+    if (width > 0 && height > 0 && (width != get_frame_width() || height != get_frame_height())) {
+        resize_frame_buffer(width, height);
+        frame_dirty = 1;
+    }
+}
+
+void end_frame(void) {
+    if (frame_dirty) publish_frame();
+    frame_active = 0;
+    frame_dirty = 0;
+}
+
+void present_output(void) {
+    if (frame_active) {
+        frame_dirty = 1;
+    } else {
+        publish_frame();
+    }
+}
+
 void clear_screen() {
-    tb_clear();
+    frame_clear();
+    present_output();
 }
 
 void clear_line(const int y, const int x_start, const int x_end) {
     for (int i = x_start; i < x_end; i++) {
-        tb_set_cell(i, y, ' ', color_mapping[DEFAULT].value, color_mapping[DEFAULT].value);
+        frame_set_cell(i, y, ' ', color_mapping[DEFAULT].value, color_mapping[DEFAULT].value);
     }
-    tb_present();
+    present_output();
 }
 
 void print_text(int x, int y, const color_t fg, const color_t bg, const char* text) {
     check_xy(&x, &y);
 
-    tb_printf(x, y, color_mapping[fg].value, color_mapping[bg].value, "%s", text);
-    tb_present();
+    frame_printf(x, y, color_mapping[fg].value, color_mapping[bg].value, "%s", text);
+    present_output();
 }
 
 void print_text_f(int x, int y, const color_t fg, const color_t bg, const char* format, ...) {
@@ -37,10 +69,10 @@ void print_text_f(int x, int y, const color_t fg, const color_t bg, const char*
     va_start(args, format);
     char buffer[1024];
     vsnprintf(buffer, sizeof(buffer), format, args);
-    tb_printf(x, y, color_mapping[fg].value, color_mapping[bg].value, "%s", buffer);
+    frame_printf(x, y, color_mapping[fg].value, color_mapping[bg].value, "%s", buffer);
     va_end(args);
 
-    tb_present();
+    present_output();
 }
 
 void print_simple_menu(int x, int y, const Menu* simple_menu) {
@@ -55,21 +87,21 @@ void print_simple_menu(int x, int y, const Menu* simple_menu) {
     const uintattr_t sel_bg = color_mapping[simple_menu->args.selected_bg].value;
 
     //print title
-    tb_printf(x, y++, uns_fg, uns_bg, "%s", simple_menu->title);
+    frame_printf(x, y++, uns_fg, uns_bg, "%s", simple_menu->title);
 
     for (int i = 0; i < simple_menu->option_count; i++) {
         // if (menu->options[i] == NULL) continue;
 
         if (i == simple_menu->selected_index &&
             simple_menu->args.mode != INACTIVE_WOUT_SEL) {
-            tb_printf(x, y++, sel_fg, sel_bg, "> %s", simple_menu->options[i]);
+            frame_printf(x, y++, sel_fg, sel_bg, "> %s", simple_menu->options[i]);
         } else {
-            tb_printf(x, y++, uns_fg, uns_bg, "  %s", simple_menu->options[i]);
+            frame_printf(x, y++, uns_fg, uns_bg, "  %s", simple_menu->options[i]);
         }
     }
 
-    tb_printf(x, y + 2, uns_fg, uns_bg, "%s", simple_menu->tailing_text);
-    tb_present();
+    frame_printf(x, y + 2, uns_fg, uns_bg, "%s", simple_menu->tailing_text);
+    present_output();
 }
 
 void print_spinner_menu(int x, int y, const Menu* spinner_menu) {
@@ -86,31 +118,31 @@ void print_spinner_menu(int x, int y, const Menu* spinner_menu) {
 
     const int spinner_x_pos = x + spinner_menu->args.max_option_length + 1;
     //print title
-    tb_printf(x, y++, uns_fg, uns_bg, "%s", spinner_menu->title);
+    frame_printf(x, y++, uns_fg, uns_bg, "%s", spinner_menu->title);
 
     for (int i = 0; i < spinner_menu->option_count; i++) {
-        tb_printf(x, y, uns_fg, uns_bg, "%s", spinner_menu->options[i]);
+        frame_printf(x, y, uns_fg, uns_bg, "%s", spinner_menu->options[i]);
         if (i == spinner_menu->selected_index / 2 &&
             spinner_menu->selected_index % 2 == 0 &&
             mode != INACTIVE_WOUT_SEL) {
             // the left symbol is marked
-            tb_printf(spinner_x_pos, y, sel_fg, sel_bg, "<");
-            tb_printf(spinner_x_pos + 2, y, uns_fg, uns_bg, ">");
+            frame_printf(spinner_x_pos, y, sel_fg, sel_bg, "<");
+            frame_printf(spinner_x_pos + 2, y, uns_fg, uns_bg, ">");
         } else if (i == spinner_menu->selected_index / 2 &&
             spinner_menu->selected_index % 2 == 1 &&
             mode != INACTIVE_WOUT_SEL) {
             // the right symbol is marked
-            tb_printf(spinner_x_pos, y, uns_fg, uns_bg, "<");
-            tb_printf(spinner_x_pos + 2, y, sel_fg, sel_bg, ">");
+            frame_printf(spinner_x_pos, y, uns_fg, uns_bg, "<");
+            frame_printf(spinner_x_pos + 2, y, sel_fg, sel_bg, ">");
         } else {
-            tb_printf(spinner_x_pos, y, uns_fg, uns_bg, "<");
-            tb_printf(spinner_x_pos + 2, y, uns_fg, uns_bg, ">");
+            frame_printf(spinner_x_pos, y, uns_fg, uns_bg, "<");
+            frame_printf(spinner_x_pos + 2, y, uns_fg, uns_bg, ">");
         }
         y += 1;
     }
 
-    tb_printf(x, y + 2, uns_fg, uns_bg, "%s", spinner_menu->tailing_text);
-    tb_present();
+    frame_printf(x, y + 2, uns_fg, uns_bg, "%s", spinner_menu->tailing_text);
+    present_output();
 }
 
 void check_xy(int* x, int* y) {
@@ -5,7 +5,25 @@
 #include "../../menu.h"
 
 /**
- * Clears the terminal screen by invoking the termbox clear functionality.
+ * Starts a frame and resizes the back buffer if the terminal was resized. Until `end_frame` is called,
+ * the output functions only write to the back buffer.
+ */
+void begin_frame(void);
+
+/**
+ * Ends the frame and publishes the back buffer as a snapshot for the render thread,
+ * if anything was written during the frame.
+ */
+void end_frame(void);
+
+/**
+ * Called by the output functions after writing to the back buffer. Inside a frame the publishing is deferred
+ * to `end_frame`, outside a frame the back buffer is published right away.
+ */
+void present_output(void);
+
+/**
+ * Clears the terminal screen by blanking the whole back buffer.
  * @note Use this function with caution, preferably before a context switch occurs.
  * (Context switch is a switch between states, for example, MAP MODE -> MAIN MENU MODE)
  */
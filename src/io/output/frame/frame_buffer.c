@@ -0,0 +1,185 @@
+#include "frame_buffer.h"
+
+#include "../../../logger/logger.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PRINT_LENGTH 1024
+
+frame_buffer_t back_buffer = {0, 0, 0, NULL};
+frame_buffer_t* target = &back_buffer;// the buffer the output functions draw into
+
+/**
+ * Sets the given range of cells to blank cells with the default colors.
+ *
+ * @param cells The first cell of the range.
+ * @param count The number of cells.
+ */
+void blank_cells(frame_cell_t* cells, int count);
+
+int init_frame_buffer(const int width, const int height) {
+    RETURN_WHEN_TRUE(width <= 0 || height <= 0, 1, "Frame Buffer", "Invalid frame size: %dx%d", width, height)
+
+    back_buffer.cells = malloc(sizeof(frame_cell_t) * width * height);
+    RETURN_WHEN_NULL(back_buffer.cells, 1, "Frame Buffer", "Failed to allocate the back buffer")
+    back_buffer.width = width;
+    back_buffer.height = height;
+    back_buffer.capacity = width * height;
+    blank_cells(back_buffer.cells, back_buffer.capacity);
+    return 0;
+}
+
+void shutdown_frame_buffer(void) {
+    free(back_buffer.cells);
+    back_buffer = (frame_buffer_t) {0, 0, 0, NULL};
+    target = &back_buffer;
+}
+
+const frame_buffer_t* get_frame_buffer(void) {
+    return back_buffer.cells == NULL ? NULL : &back_buffer;
+}
+
+int resize_frame_buffer(const int width, const int height) {
+    RETURN_WHEN_TRUE(width <= 0 || height <= 0, 1, "Frame Buffer", "Invalid frame size: %dx%d", width, height)
+    if (width == back_buffer.width && height == back_buffer.height) return 0;
+
+    frame_cell_t* cells = malloc(sizeof(frame_cell_t) * width * height);
+    RETURN_WHEN_NULL(cells, 1, "Frame Buffer", "Failed to allocate the resized back buffer")
+    blank_cells(cells, width * height);
+
+    // keep the overlapping area, so the caches of the output modules stay valid
+    const int copy_width = width < back_buffer.width ? width : back_buffer.width;
+    const int copy_height = height < back_buffer.height ? height : back_buffer.height;
+    for (int y = 0; y < copy_height; y++) {
+        memcpy(&cells[y * width], &back_buffer.cells[y * back_buffer.width], sizeof(frame_cell_t) * copy_width);
+    }
+
+    free(back_buffer.cells);
+    back_buffer.cells = cells;
+    back_buffer.width = width;
+    back_buffer.height = height;
+    back_buffer.capacity = width * height;
+    return 0;
+}
+
+int get_frame_width(void) {
+    return back_buffer.width;
+}
+
+int get_frame_height(void) {
+    return back_buffer.height;
+}
+
+int copy_frame_buffer(frame_buffer_t* dst, const frame_buffer_t* src) {
+    RETURN_WHEN_NULL(dst, 1, "Frame Buffer", "In `copy_frame_buffer` dst is NULL")
+    RETURN_WHEN_NULL(src, 1, "Frame Buffer", "In `copy_frame_buffer` src is NULL")
+
+    const int count = src->width * src->height;
+    if (count > dst->capacity) {
+        frame_cell_t* cells = malloc(sizeof(frame_cell_t) * count);
+        RETURN_WHEN_NULL(cells, 1, "Frame Buffer", "Failed to grow the frame buffer to %d cells", count)
+        free(dst->cells);
+        dst->cells = cells;
+        dst->capacity = count;
+    }
+    memcpy(dst->cells, src->cells, sizeof(frame_cell_t) * count);
+    dst->width = src->width;
+    dst->height = src->height;
+    return 0;
+}
+
+void frame_clear(void) {
+    blank_cells(target->cells, target->width * target->height);
+}
+
+frame_buffer_t* redirect_frame_output(frame_buffer_t* buffer) {
+    frame_buffer_t* previous = target == &back_buffer ? NULL : target;
+    target = buffer == NULL ? &back_buffer : buffer;
+    return previous;
+}
+
+void blit_frame_buffer(const int x, const int y, const frame_buffer_t* src) {
+    copy_frame_cells(target, x, y, src);
+}
+
+void copy_frame_cells(frame_buffer_t* dst, const int x, const int y, const frame_buffer_t* src) {
+    RETURN_WHEN_NULL(dst, , "Frame Buffer", "In `copy_frame_cells` dst is NULL")
+    RETURN_WHEN_NULL(src, , "Frame Buffer", "In `copy_frame_cells` src is NULL")
+
+    // clip the source against the destination once, instead of checking every cell
+    const int start_i = x < 0 ? -x : 0;
+    const int start_j = y < 0 ? -y : 0;
+    const int end_i = x + src->width > dst->width ? dst->width - x : src->width;
+    const int end_j = y + src->height > dst->height ? dst->height - y : src->height;
+
+    for (int j = start_j; j < end_j; j++) {
+        const frame_cell_t* row = &src->cells[j * src->width];
+        frame_cell_t* dst_row = &dst->cells[(y + j) * dst->width + x];
+        for (int i = start_i; i < end_i; i++) {
+            if (row[i].ch != FRAME_TRANSPARENT) dst_row[i] = row[i];
+        }
+    }
+}
+
+void trim_frame_buffer(frame_buffer_t* buffer) {
+    RETURN_WHEN_NULL(buffer, , "Frame Buffer", "In `trim_frame_buffer` buffer is NULL")
+
+    int width = 0;
+    int height = 0;
+    for (int j = 0; j < buffer->height; j++) {
+        for (int i = 0; i < buffer->width; i++) {
+            if (buffer->cells[j * buffer->width + i].ch == FRAME_TRANSPARENT) continue;
+            if (i >= width) width = i + 1;
+            height = j + 1;
+        }
+    }
+
+    // the rows only move to lower indices, so they can be compacted in place
+    for (int j = 0; j < height; j++) {
+        memmove(&buffer->cells[j * width], &buffer->cells[j * buffer->width], sizeof(frame_cell_t) * width);
+    }
+    buffer->width = width;
+    buffer->height = height;
+}
+
+void frame_set_cell(const int x, const int y, const uint32_t ch, const uintattr_t fg, const uintattr_t bg) {
+    if (x < 0 || y < 0 || x >= target->width || y >= target->height) return;
+
+    frame_cell_t* cell = &target->cells[y * target->width + x];
+    cell->ch = ch;
+    cell->fg = fg;
+    cell->bg = bg;
+}
+
+void frame_printf(const int x, int y, const uintattr_t fg, const uintattr_t bg, const char* format, ...) {
+    char buffer[MAX_PRINT_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    int cx = x;
+    const char* str = buffer;
+    while (*str != '\0') {
+        uint32_t ch;
+        const int length = tb_utf8_char_to_unicode(&ch, str);
+        if (length <= 0) break;// invalid utf-8 sequence, the rest of the string is dropped
+        str += length;
+
+        if (ch == '\n') {
+            cx = x;
+            y++;
+        } else {
+            frame_set_cell(cx++, y, ch, fg, bg);
+        }
+    }
+}
+
+void blank_cells(frame_cell_t* cells, const int count) {
+    for (int i = 0; i < count; i++) {
+        cells[i] = (frame_cell_t) {' ', TB_DEFAULT, TB_DEFAULT};
+    }
+}
@@ -0,0 +1,138 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include "../../../../termbox2/termbox2.h"
+
+#define FRAME_TRANSPARENT 0// codepoint of cells that `blit_frame_buffer` skips
+
+typedef struct {
+    uint32_t ch;  // unicode codepoint of the cell
+    uintattr_t fg;// termbox foreground attributes
+    uintattr_t bg;// termbox background attributes
+} frame_cell_t;
+
+/**
+ * A grid of screen cells. The output functions draw into the back buffer, which is copied into an immutable
+ * snapshot at the end of each frame and written to the output backend by the render thread.
+ */
+typedef struct {
+    int width;
+    int height;
+    int capacity;       // number of cells the buffer can hold
+    frame_cell_t* cells;// index y * width + x
+} frame_buffer_t;
+
+/**
+ * Creates the back buffer with the given dimensions, all cells are blank.
+ *
+ * @param width The width of the screen in cells.
+ * @param height The height of the screen in cells.
+ * @return 0 on success, 1 if the allocation failed.
+ */
+int init_frame_buffer(int width, int height);
+
+/**
+ * Frees the back buffer.
+ */
+void shutdown_frame_buffer(void);
+
+/**
+ * @return The back buffer the output functions draw into, or NULL if it wasn't initialized.
+ */
+const frame_buffer_t* get_frame_buffer(void);
+
+/**
+ * Resizes the back buffer. The cells that stay on the screen keep their content, new cells are blank.
+ *
+ * @param width The new width of the screen in cells.
+ * @param height The new height of the screen in cells.
+ * @return 0 on success, 1 if the allocation failed.
+ */
+int resize_frame_buffer(int width, int height);
+
+/**
+ * @return The width of the back buffer in cells.
+ */
+int get_frame_width(void);
+
+/**
+ * @return The height of the back buffer in cells.
+ */
+int get_frame_height(void);
+
+/**
+ * Copies the cells of a frame buffer into another one, growing the destination if necessary.
+ *
+ * @param dst The destination buffer, its cells are allocated with malloc.
+ * @param src The source buffer.
+ * @return 0 on success, 1 if the allocation failed.
+ */
+int copy_frame_buffer(frame_buffer_t* dst, const frame_buffer_t* src);
+
+/**
+ * Redirects the output functions into another frame buffer, e.g. to record a panel once and copy it into
+ * the back buffer in later frames with `blit_frame_buffer`.
+ *
+ * @param buffer The buffer to draw into, NULL restores the back buffer.
+ * @return The previous target, NULL if it was the back buffer.
+ */
+frame_buffer_t* redirect_frame_output(frame_buffer_t* buffer);
+
+/**
+ * Copies the cells of a frame buffer to the given position of the current target.
+ * Cells with the codepoint FRAME_TRANSPARENT are skipped, so only the drawn cells are copied.
+ *
+ * @param x The x-coordinate of the top left cell.
+ * @param y The y-coordinate of the top left cell.
+ * @param src The buffer to copy.
+ */
+void blit_frame_buffer(int x, int y, const frame_buffer_t* src);
+
+/**
+ * Copies the cells of a frame buffer to the given position of another frame buffer.
+ * Cells with the codepoint FRAME_TRANSPARENT are skipped.
+ *
+ * @param dst The destination buffer.
+ * @param x The x-coordinate of the top left cell in the destination.
+ * @param y The y-coordinate of the top left cell in the destination.
+ * @param src The buffer to copy.
+ */
+void copy_frame_cells(frame_buffer_t* dst, int x, int y, const frame_buffer_t* src);
+
+/**
+ * Shrinks a frame buffer to the bounding box of its cells that aren't FRAME_TRANSPARENT, anchored at the
+ * top left cell. The capacity is kept, so the buffer can be drawn into again after restoring its size.
+ *
+ * @param buffer The buffer to trim.
+ */
+void trim_frame_buffer(frame_buffer_t* buffer);
+
+/**
+ * Sets all cells of the current target to blank cells with the default colors.
+ */
+void frame_clear(void);
+
+/**
+ * Sets a single cell of the current target. Cells outside the buffer are ignored.
+ *
+ * @param x The x-coordinate of the cell.
+ * @param y The y-coordinate of the cell.
+ * @param ch The unicode codepoint of the cell.
+ * @param fg The termbox foreground attributes.
+ * @param bg The termbox background attributes.
+ */
+void frame_set_cell(int x, int y, uint32_t ch, uintattr_t fg, uintattr_t bg);
+
+/**
+ * Formats an utf-8 string into the current target, the drop-in replacement of `tb_printf`.
+ * A newline continues the text in the next row at the x-coordinate of the anchor.
+ *
+ * @param x The x-coordinate of the first character.
+ * @param y The y-coordinate of the first character.
+ * @param fg The termbox foreground attributes.
+ * @param bg The termbox background attributes.
+ * @param format The printf format string.
+ */
+void frame_printf(int x, int y, uintattr_t fg, uintattr_t bg, const char* format, ...);
+
+#endif//FRAME_BUFFER_H
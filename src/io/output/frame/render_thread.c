@@ -0,0 +1,208 @@
+#include "render_thread.h"
+
+#include "../../../helper/time_helper.h"
+#include "../../../logger/logger.h"
+#include "../../../thread/thread_handler.h"
+#include "../backend/output_backend.h"
+#include "frame_buffer.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #define MUTEX CRITICAL_SECTION
+    #define CONDITION CONDITION_VARIABLE
+
+    #define INIT_MUTEX(mutex) InitializeCriticalSection(mutex)
+    #define INIT_COND(cond) InitializeConditionVariable(cond)
+    #define DESTROY_MUTEX(mutex) DeleteCriticalSection(mutex)
+    #define DESTROY_COND(cond)
+
+    #define MUTEX_LOCK(mutex) EnterCriticalSection(mutex)
+    #define MUTEX_UNLOCK(mutex) LeaveCriticalSection(mutex)
+    #define SIGNAL_COND(cond) WakeConditionVariable(cond)
+    #define SIGNAL_WAIT(cond, mutex) SleepConditionVariableCS(cond, mutex, INFINITE)
+#else
+    #include <pthread.h>
+    #define MUTEX pthread_mutex_t
+    #define CONDITION pthread_cond_t
+
+    #define INIT_MUTEX(mutex) pthread_mutex_init(mutex, NULL)
+    #define INIT_COND(cond) pthread_cond_init(cond, NULL)
+    #define DESTROY_MUTEX(mutex) pthread_mutex_destroy(mutex)
+    #define DESTROY_COND(cond) pthread_cond_destroy(cond)
+
+    #define MUTEX_LOCK(mutex) pthread_mutex_lock(mutex)
+    #define MUTEX_UNLOCK(mutex) pthread_mutex_unlock(mutex)
+    #define SIGNAL_COND(cond) pthread_cond_signal(cond)
+    #define SIGNAL_WAIT(cond, mutex) pthread_cond_wait(cond, mutex)
+#endif
+
+/**
+ * The snapshots shared with the render thread. Together with the back buffer of the game logic this is a
+ * triple buffer: the logic copies its back buffer into `pending`, the render thread swaps `pending` with
+ * `front` and writes `front` to the terminal, while the logic already draws the next frame.
+ */
+typedef struct {
+    frame_buffer_t pending;// the newest published frame, only valid if `pending_ready` is set
+    frame_buffer_t front;  // the frame the render thread writes to the terminal
+    long long pending_input_time;// poll time of the oldest input shown first by `pending`, 0 if none
+    long long front_input_time;
+    int pending_ready;
+    int running;
+    MUTEX mutex;
+    CONDITION cond;
+    thread_t thread;
+} render_state_t;
+
+render_state_t render_state;
+atomic_int render_thread_active = 0;
+atomic_int screen_width = -1;
+atomic_int screen_height = -1;
+atomic_llong input_latency_ns = -1;
+
+// only accessed by the game logic
+const frame_buffer_t* overlay = NULL;// drawn over every published frame, without touching the back buffer
+int overlay_x = 0;
+int overlay_y = 0;
+long long frame_input_time = 0;// poll time of the input handled in the current frame, 0 if none
+frame_buffer_t sync_frame = {0, 0, 0, NULL};// the composed frame, when there is no render thread
+
+/**
+ * The loop of the render thread, waits for published frames and writes them to the terminal.
+ *
+ * @param arg unused
+ */
+void render_loop(void* arg);
+
+int start_render_thread(void) {
+    RETURN_WHEN_TRUE(render_thread_active, 1, "Render Thread", "The render thread is already running")
+    RETURN_WHEN_NULL(get_frame_buffer(), 1, "Render Thread", "The back buffer isn't initialized")
+
+    render_state.pending = (frame_buffer_t) {0, 0, 0, NULL};
+    render_state.front = (frame_buffer_t) {0, 0, 0, NULL};
+    render_state.pending_input_time = 0;
+    render_state.front_input_time = 0;
+    render_state.pending_ready = 0;
+    render_state.running = 1;
+    INIT_MUTEX(&render_state.mutex);
+    INIT_COND(&render_state.cond);
+
+    Output_Backend* backend = get_output_backend();
+    screen_width = backend->width(backend);
+    screen_height = backend->height(backend);
+    if (start_joinable_thread(&render_state.thread, render_loop, NULL) != 0) {
+        log_msg(ERROR, "Render Thread", "Failed to start the render thread");
+        DESTROY_COND(&render_state.cond);
+        DESTROY_MUTEX(&render_state.mutex);
+        return 1;
+    }
+    render_thread_active = 1;
+    return 0;
+}
+
+void stop_render_thread(void) {
+    free(sync_frame.cells);
+    sync_frame = (frame_buffer_t) {0, 0, 0, NULL};
+    if (!render_thread_active) return;
+
+    MUTEX_LOCK(&render_state.mutex);
+    render_state.running = 0;
+    SIGNAL_COND(&render_state.cond);
+    MUTEX_UNLOCK(&render_state.mutex);
+    join_thread(render_state.thread);
+    render_thread_active = 0;
+
+    DESTROY_COND(&render_state.cond);
+    DESTROY_MUTEX(&render_state.mutex);
+    free(render_state.pending.cells);
+    free(render_state.front.cells);
+    screen_width = -1;
+    screen_height = -1;
+}
+
+void publish_frame(void) {
+    const frame_buffer_t* back = get_frame_buffer();
+    RETURN_WHEN_NULL(back, , "Render Thread", "The back buffer isn't initialized")
+
+    if (!render_thread_active) {
+        const frame_buffer_t* frame = back;
+        if (overlay != NULL && copy_frame_buffer(&sync_frame, back) == 0) {
+            copy_frame_cells(&sync_frame, overlay_x, overlay_y, overlay);
+            frame = &sync_frame;
+        }
+        Output_Backend* backend = get_output_backend();
+        backend->write_frame(backend, frame);
+        if (frame_input_time != 0) input_latency_ns = monotonic_ns() - frame_input_time;
+        frame_input_time = 0;
+        return;
+    }
+
+    MUTEX_LOCK(&render_state.mutex);
+    if (copy_frame_buffer(&render_state.pending, back) == 0) {
+        if (overlay != NULL) copy_frame_cells(&render_state.pending, overlay_x, overlay_y, overlay);
+        // a replaced snapshot passes the input it showed first on to the new one
+        if (!render_state.pending_ready || render_state.pending_input_time == 0) {
+            render_state.pending_input_time = frame_input_time;
+        }
+        render_state.pending_ready = 1;
+        SIGNAL_COND(&render_state.cond);
+    }
+    MUTEX_UNLOCK(&render_state.mutex);
+    frame_input_time = 0;
+}
+
+void set_frame_overlay(const frame_buffer_t* frame_overlay, const int x, const int y) {
+    overlay = frame_overlay;
+    overlay_x = x;
+    overlay_y = y;
+}
+
+void mark_frame_input(const long long input_time) {
+    if (frame_input_time == 0) frame_input_time = input_time;
+}
+
+long long get_input_latency_ns(void) {
+    return input_latency_ns;
+}
+
+int get_screen_width(void) {
+    return screen_width;
+}
+
+int get_screen_height(void) {
+    return screen_height;
+}
+
+void render_loop(void* arg) {
+    (void) arg;
+    Output_Backend* backend = get_output_backend();
+
+    while (1) {
+        MUTEX_LOCK(&render_state.mutex);
+        while (!render_state.pending_ready && render_state.running) {
+            SIGNAL_WAIT(&render_state.cond, &render_state.mutex);
+        }
+        if (!render_state.pending_ready) {
+            // stopped and every published frame was written
+            MUTEX_UNLOCK(&render_state.mutex);
+            break;
+        }
+        const frame_buffer_t published = render_state.pending;
+        render_state.pending = render_state.front;
+        render_state.front = published;
+        render_state.front_input_time = render_state.pending_input_time;
+        render_state.pending_input_time = 0;
+        render_state.pending_ready = 0;
+        MUTEX_UNLOCK(&render_state.mutex);
+
+        // the frame is written outside the lock, the logic can publish the next frame meanwhile
+        backend->write_frame(backend, &render_state.front);
+        screen_width = backend->width(backend);
+        screen_height = backend->height(backend);
+        if (render_state.front_input_time != 0) {
+            input_latency_ns = monotonic_ns() - render_state.front_input_time;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include "frame_buffer.h"
+
+/**
+ * Starts the render thread, which owns the output backend from now on. The backend and the back buffer
+ * must be initialized.
+ *
+ * @return 0 if the thread was started, 1 otherwise.
+ */
+int start_render_thread(void);
+
+/**
+ * Writes the last published frame to the backend and stops the render thread.
+ */
+void stop_render_thread(void);
+
+/**
+ * Publishes the back buffer as the next frame. While the render thread runs, the back buffer is copied into
+ * a snapshot and the function returns without waiting for the backend. A snapshot that wasn't picked up yet
+ * is replaced, so a slow terminal drops frames instead of delaying the game logic.
+ * Without a render thread the back buffer is written to the backend directly.
+ */
+void publish_frame(void);
+
+/**
+ * Sets a frame buffer that is drawn over every published frame, e.g. a debug overlay. The back buffer isn't
+ * changed, so removing the overlay needs no redraw of the covered cells, only a new published frame.
+ *
+ * @param frame_overlay The overlay, cells with the codepoint FRAME_TRANSPARENT are skipped. NULL removes it.
+ * @param x The x-coordinate of the overlay on the screen.
+ * @param y The y-coordinate of the overlay on the screen.
+ */
+void set_frame_overlay(const frame_buffer_t* frame_overlay, int x, int y);
+
+/**
+ * Marks that the current frame handles an input, the time from polling the input until the frame is
+ * presented is measured. If several inputs are marked before a frame is published, the first one counts.
+ *
+ * @param input_time The monotonic poll time of the input in nanoseconds.
+ */
+void mark_frame_input(long long input_time);
+
+/**
+ * @return The time in nanoseconds from polling an input until the frame handling it was presented,
+ *         measured for the last presented input, or -1 if none was presented yet.
+ */
+long long get_input_latency_ns(void);
+
+/**
+ * @return The width of the screen as last seen by the render thread, or -1 if it isn't running.
+ */
+int get_screen_width(void);
+
+/**
+ * @return The height of the screen as last seen by the render thread, or -1 if it isn't running.
+ */
+int get_screen_height(void);
+
+#endif//RENDER_THREAD_H
@@ -1,11 +1,22 @@
 #include "output.h"
 
+#include "backend/output_backend.h"
+#include "frame/frame_buffer.h"
+#include "frame/render_thread.h"
 #include "specific/character_output.h"
+#include "specific/perf_hud.h"
 
 int init_output(void) {
+    const Output_Backend* backend = get_output_backend();
+    if (init_frame_buffer(backend->width(backend), backend->height(backend)) != 0) return 1;
+    if (start_render_thread() != 0) return 1;
+    if (init_perf_hud() != 0) return 1;
     return init_character_output();
 }
 
 void shutdown_output(void) {
     shutdown_character_output();
+    shutdown_perf_hud();
+    stop_render_thread();
+    shutdown_frame_buffer();
 }
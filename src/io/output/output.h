@@ -2,7 +2,8 @@
 #define OUTPUT_H
 
 /**
- * Initializes the output subsystem.
+ * Initializes the output subsystem: the back buffer sized like the screen of the output backend,
+ * the render thread owning the backend and the character output.
  *
  * @return Returns 0 on successful initialization, or a non-zero value
  *         if an error occurs during the initialization process.
@@ -10,8 +11,7 @@
 int init_output(void);
 
 /**
- * Shuts down the output subsystem by delegating the shutdown process
- * to the character output module.
+ * Shuts down the output subsystem. The render thread writes the last published frame before it stops.
  */
 void shutdown_output(void);
 
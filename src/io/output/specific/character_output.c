@@ -1,10 +1,11 @@
 #include "character_output.h"
 
-#include "../../../../termbox2/termbox2.h"
 #include "../../../logger/logger.h"
 #include "../../colors.h"
 #include "../../local/local_handler.h"
 #include "../../string_formats.h"
+#include "../common/common_output.h"
+#include "../frame/frame_buffer.h"
 
 #include <stdio.h>
 
@@ -27,6 +28,11 @@
 #define COLUMN3_OFFSET_LV (COLUMN2_OFFSET_LV + COLUMN_WIDTH_V)
 #define COLUMN3_OFFSET_SV (COLUMN2_OFFSET_SV + COLUMN_WIDTH_V)
 
+// the formatted panels are cached, so an unchanged panel is copied instead of formatted again
+#define PANEL_CACHE_SLOTS 4// enough for the player and an enemy in every layout shown at the same time
+#define PANEL_WIDTH 100
+#define PANEL_HEIGHT 10
+
 enum co_str_index {
     LEVEL_STR,
     HEALTH_STR,
@@ -48,7 +54,48 @@ enum co_str_index {
     MAX_CO_STRINGS
 };
 
+typedef enum {
+    PANEL_HORIZONTAL,
+    PANEL_VERTICAL
+} panel_layout_t;
+
+typedef struct {
+    const Character* character;// NULL if the slot is empty
+    unsigned int stats_version;// stats version of the character when the panel was formatted
+    output_args_c_t args;
+    panel_layout_t layout;
+    frame_buffer_t panel;// the formatted panel, cells that weren't drawn are FRAME_TRANSPARENT
+} panel_cache_entry_t;
+
 char** co_strings = NULL;
+panel_cache_entry_t panel_cache[PANEL_CACHE_SLOTS];
+int next_panel_slot = 0;// the slot replaced on the next miss
+
+/**
+ * Returns the formatted panel of the character, formatting it only if the character's stats, the layout
+ * or the language changed since it was cached.
+ *
+ * @param character The character to show.
+ * @param args The output arguments of the panel.
+ * @param layout The layout of the panel.
+ * @return The panel, drawn at (0, 0).
+ */
+const frame_buffer_t* get_character_panel(const Character* character, output_args_c_t args, panel_layout_t layout);
+
+/**
+ * Formats the horizontal character panel into the current frame target.
+ */
+void draw_char_h(int x, int y, const Character* character, output_args_c_t args);
+
+/**
+ * Formats the vertical character panel into the current frame target.
+ */
+void draw_char_v(int x, int y, const Character* character, output_args_c_t args);
+
+/**
+ * Empties all slots of the panel cache.
+ */
+void invalidate_panel_cache(void);
 
 void print_attr_h(int x, int y, const attributes_t* attr_base, const attributes_t* attr_bonus);
 
@@ -64,42 +111,97 @@ int init_character_output() {
         co_strings[i] = NULL;
     }
 
+    for (int i = 0; i < PANEL_CACHE_SLOTS; i++) {
+        panel_cache[i].character = NULL;
+        panel_cache[i].panel = (frame_buffer_t) {PANEL_WIDTH, PANEL_HEIGHT, PANEL_WIDTH * PANEL_HEIGHT, NULL};
+        panel_cache[i].panel.cells = malloc(sizeof(frame_cell_t) * PANEL_WIDTH * PANEL_HEIGHT);
+        RETURN_WHEN_NULL(panel_cache[i].panel.cells, 1, "Character Output", "Failed to allocate the panel cache.")
+    }
+
     update_character_output_local();
     observe_local(update_character_output_local);
     return 0;
 }
 
-void print_char_h(const int x, int y, const Character* character, const output_args_c_t args) {
+void print_char_h(const int x, const int y, const Character* character, const output_args_c_t args) {
+    RETURN_WHEN_NULL(co_strings, , "Character Output", "Module not initialized.")
+    RETURN_WHEN_NULL(character, , "Character Output", "In `print_c_res_attr_hori` given player is NULL.")
+
+    blit_frame_buffer(x, y, get_character_panel(character, args, PANEL_HORIZONTAL));
+    present_output();
+}
+
+void print_char_v(const int x, const int y, const Character* character, const output_args_c_t args) {
     RETURN_WHEN_NULL(co_strings, , "Character Output", "Module not initialized.")
     RETURN_WHEN_NULL(character, , "Character Output", "In `print_c_res_attr_hori` given player is NULL.")
 
+    blit_frame_buffer(x, y, get_character_panel(character, args, PANEL_VERTICAL));
+    present_output();
+}
+
+const frame_buffer_t* get_character_panel(const Character* character, const output_args_c_t args,
+                                          const panel_layout_t layout) {
+    for (int i = 0; i < PANEL_CACHE_SLOTS; i++) {
+        const panel_cache_entry_t* entry = &panel_cache[i];
+        if (entry->character == character && entry->stats_version == character->stats_version &&
+            entry->layout == layout && entry->args.arg_short == args.arg_short &&
+            entry->args.arg_res == args.arg_res && entry->args.arg_attr == args.arg_attr) {
+            return &entry->panel;
+        }
+    }
+
+    panel_cache_entry_t* entry = &panel_cache[next_panel_slot];
+    next_panel_slot = (next_panel_slot + 1) % PANEL_CACHE_SLOTS;
+    entry->panel.width = PANEL_WIDTH;
+    entry->panel.height = PANEL_HEIGHT;
+    for (int i = 0; i < PANEL_WIDTH * PANEL_HEIGHT; i++) {
+        entry->panel.cells[i] = (frame_cell_t) {FRAME_TRANSPARENT, TB_DEFAULT, TB_DEFAULT};
+    }
+
+    frame_buffer_t* previous = redirect_frame_output(&entry->panel);
+    if (layout == PANEL_HORIZONTAL) {
+        draw_char_h(0, 0, character, args);
+    } else {
+        draw_char_v(0, 0, character, args);
+    }
+    redirect_frame_output(previous);
+    trim_frame_buffer(&entry->panel);// copying the panel only visits its drawn area
+
+    entry->character = character;
+    entry->stats_version = character->stats_version;
+    entry->args = args;
+    entry->layout = layout;
+    return &entry->panel;
+}
+
+void draw_char_h(const int x, int y, const Character* character, const output_args_c_t args) {
     const uintattr_t c_white = color_mapping[WHITE].value;
     const uintattr_t c_default = color_mapping[DEFAULT].value;
 
     // print name and level
     char* char_name = character->id == 0 ? character->name : get_local_string(character->name);
-    tb_printf(x, y++, c_white, c_default, NAME_LVL_FORMAT_C,
+    frame_printf(x, y++, c_white, c_default, NAME_LVL_FORMAT_C,
               char_name, co_strings[LEVEL_STR], character->level);
     if (character->id != 0) free(char_name);
 
     // prepare offset for the resource strings
     int offset = args.arg_short == 0 ? HEALTH_STR : HEALTH_SHORT_STR;
     // print the resources
-    tb_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%s  ", co_strings[offset]);
-    tb_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 1]);
-    tb_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 2]);
+    frame_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%s  ", co_strings[offset]);
+    frame_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 1]);
+    frame_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 2]);
     y++;
     if (args.arg_res == RES_CURR_MAX) {
-        tb_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%d/%d  ",
+        frame_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%d/%d  ",
                   character->current_resources.health, character->max_resources.health);
-        tb_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %d/%d  ",
+        frame_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %d/%d  ",
                   character->current_resources.stamina, character->max_resources.stamina);
-        tb_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %d/%d  ",
+        frame_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %d/%d  ",
                   character->current_resources.mana, character->max_resources.mana);
     } else {
-        tb_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%d  ", character->base_resources.health);
-        tb_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %d  ", character->base_resources.stamina);
-        tb_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %d  ", character->base_resources.mana);
+        frame_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%d  ", character->base_resources.health);
+        frame_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %d  ", character->base_resources.stamina);
+        frame_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %d  ", character->base_resources.mana);
     }
     y++;
 
@@ -107,17 +209,17 @@ void print_char_h(const int x, int y, const Character* character, const output_a
     offset = args.arg_short == 0 ? STRENGTH_STR : STRENGTH_SHORT_STR;
     const attributes_t attr = args.arg_attr == ATTR_BASE ? character->base_attributes : character->max_attributes;
     // print the attributes
-    tb_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%s  ", co_strings[offset]);
-    tb_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 1]);
-    tb_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 2]);
-    tb_printf(x + COLUMN4_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 3]);
-    tb_printf(x + COLUMN5_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 4]);
+    frame_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%s  ", co_strings[offset]);
+    frame_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 1]);
+    frame_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 2]);
+    frame_printf(x + COLUMN4_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 3]);
+    frame_printf(x + COLUMN5_OFFSET_H, y, c_white, c_default, "| %s  ", co_strings[offset + 4]);
     y++;
-    tb_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%d  ", attr.strength);
-    tb_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %d  ", attr.intelligence);
-    tb_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %d  ", attr.agility);
-    tb_printf(x + COLUMN4_OFFSET_H, y, c_white, c_default, "| %d  ", attr.constitution);
-    tb_printf(x + COLUMN5_OFFSET_H, y, c_white, c_default, "| %d  ", attr.luck);
+    frame_printf(x + COLUMN1_OFFSET_H, y, c_white, c_default, "%d  ", attr.strength);
+    frame_printf(x + COLUMN2_OFFSET_H, y, c_white, c_default, "| %d  ", attr.intelligence);
+    frame_printf(x + COLUMN3_OFFSET_H, y, c_white, c_default, "| %d  ", attr.agility);
+    frame_printf(x + COLUMN4_OFFSET_H, y, c_white, c_default, "| %d  ", attr.constitution);
+    frame_printf(x + COLUMN5_OFFSET_H, y, c_white, c_default, "| %d  ", attr.luck);
     y++;
 
     // pint the base & bonus attr info, when needed
@@ -130,41 +232,36 @@ void print_char_h(const int x, int y, const Character* character, const output_a
                          &character->base_attributes, &character->inventory->total_attribute_bonus);
         }
     }
-
-    tb_present();
 }
 
-void print_char_v(int x, int y, const Character* character, const output_args_c_t args) {
-    RETURN_WHEN_NULL(co_strings, , "Character Output", "Module not initialized.")
-    RETURN_WHEN_NULL(character, , "Character Output", "In `print_c_res_attr_hori` given player is NULL.")
-
+void draw_char_v(int x, int y, const Character* character, const output_args_c_t args) {
     const uintattr_t c_white = color_mapping[WHITE].value;
     const uintattr_t c_default = color_mapping[DEFAULT].value;
 
     // print name and level
     char* char_name = character->id == 0 ? character->name : get_local_string(character->name);
-    tb_printf(x++, y++, c_white, c_default, NAME_LVL_FORMAT_C,
+    frame_printf(x++, y++, c_white, c_default, NAME_LVL_FORMAT_C,
               char_name, co_strings[LEVEL_STR], character->level);
     if (character->id != 0) free(char_name);
 
     // prepare offset for the resource strings
     int str_offset = args.arg_short == 0 ? HEALTH_STR : HEALTH_SHORT_STR;
     // print the resources
-    tb_printf(x, y, c_white, c_default, "%s: ", co_strings[str_offset]);
-    tb_printf(x, y + 1, c_white, c_default, "%s: ", co_strings[str_offset + 1]);
-    tb_printf(x, y + 2, c_white, c_default, "%s: ", co_strings[str_offset + 2]);
+    frame_printf(x, y, c_white, c_default, "%s: ", co_strings[str_offset]);
+    frame_printf(x, y + 1, c_white, c_default, "%s: ", co_strings[str_offset + 1]);
+    frame_printf(x, y + 2, c_white, c_default, "%s: ", co_strings[str_offset + 2]);
     int x_offset = args.arg_short == 0 ? COLUMN2_OFFSET_LV : COLUMN2_OFFSET_SV;
     if (args.arg_res == RES_CURR_MAX) {
-        tb_printf(x + x_offset, y, c_white, c_default, "%d/%d ",
+        frame_printf(x + x_offset, y, c_white, c_default, "%d/%d ",
                   character->current_resources.health, character->max_resources.health);
-        tb_printf(x + x_offset, y + 1, c_white, c_default, "%d/%d ",
+        frame_printf(x + x_offset, y + 1, c_white, c_default, "%d/%d ",
                   character->current_resources.stamina, character->max_resources.stamina);
-        tb_printf(x + x_offset, y + 2, c_white, c_default, "%d/%d ",
+        frame_printf(x + x_offset, y + 2, c_white, c_default, "%d/%d ",
                   character->current_resources.mana, character->max_resources.mana);
     } else {
-        tb_printf(x + x_offset, y, c_white, c_default, "%d ", character->base_resources.health);
-        tb_printf(x + x_offset, y + 1, c_white, c_default, "%d ", character->base_resources.stamina);
-        tb_printf(x + x_offset, y + 2, c_white, c_default, "%d ", character->base_resources.mana);
+        frame_printf(x + x_offset, y, c_white, c_default, "%d ", character->base_resources.health);
+        frame_printf(x + x_offset, y + 1, c_white, c_default, "%d ", character->base_resources.stamina);
+        frame_printf(x + x_offset, y + 2, c_white, c_default, "%d ", character->base_resources.mana);
     }
     y += 4;
 
@@ -172,17 +269,17 @@ void print_char_v(int x, int y, const Character* character, const output_args_c_
     str_offset = args.arg_short == 0 ? STRENGTH_STR : STRENGTH_SHORT_STR;
     const attributes_t attr = args.arg_attr == ATTR_MAX ? character->max_attributes : character->base_attributes;
     // print the attributes
-    tb_printf(x, y, c_white, c_default, "%s: ", co_strings[str_offset]);
-    tb_printf(x, y + 1, c_white, c_default, "%s: ", co_strings[str_offset + 1]);
-    tb_printf(x, y + 2, c_white, c_default, "%s: ", co_strings[str_offset + 2]);
-    tb_printf(x, y + 3, c_white, c_default, "%s: ", co_strings[str_offset + 3]);
-    tb_printf(x, y + 4, c_white, c_default, "%s: ", co_strings[str_offset + 4]);
+    frame_printf(x, y, c_white, c_default, "%s: ", co_strings[str_offset]);
+    frame_printf(x, y + 1, c_white, c_default, "%s: ", co_strings[str_offset + 1]);
+    frame_printf(x, y + 2, c_white, c_default, "%s: ", co_strings[str_offset + 2]);
+    frame_printf(x, y + 3, c_white, c_default, "%s: ", co_strings[str_offset + 3]);
+    frame_printf(x, y + 4, c_white, c_default, "%s: ", co_strings[str_offset + 4]);
     x_offset = args.arg_short == 0 ? COLUMN2_OFFSET_LV : COLUMN2_OFFSET_SV;
-    tb_printf(x + x_offset, y, c_white, c_default, "%d ", attr.strength);
-    tb_printf(x + x_offset, y + 1, c_white, c_default, "%d ", attr.intelligence);
-    tb_printf(x + x_offset, y + 2, c_white, c_default, "%d ", attr.agility);
-    tb_printf(x + x_offset, y + 3, c_white, c_default, "%d ", attr.constitution);
-    tb_printf(x + x_offset, y + 4, c_white, c_default, "%d ", attr.luck);
+    frame_printf(x + x_offset, y, c_white, c_default, "%d ", attr.strength);
+    frame_printf(x + x_offset, y + 1, c_white, c_default, "%d ", attr.intelligence);
+    frame_printf(x + x_offset, y + 2, c_white, c_default, "%d ", attr.agility);
+    frame_printf(x + x_offset, y + 3, c_white, c_default, "%d ", attr.constitution);
+    frame_printf(x + x_offset, y + 4, c_white, c_default, "%d ", attr.luck);
 
     x_offset = args.arg_short == 0 ? COLUMN3_OFFSET_LV : COLUMN3_OFFSET_SV;
     // pint the base & bonus attr info, when needed
@@ -195,8 +292,6 @@ void print_char_v(int x, int y, const Character* character, const output_args_c_
                          &character->base_attributes, &character->inventory->total_attribute_bonus);
         }
     }
-
-    tb_present();
 }
 
 void shutdown_character_output(void) {
@@ -207,6 +302,18 @@ void shutdown_character_output(void) {
     }
     free(co_strings);
     co_strings = NULL;
+
+    for (int i = 0; i < PANEL_CACHE_SLOTS; i++) {
+        free(panel_cache[i].panel.cells);
+        panel_cache[i].panel.cells = NULL;
+        panel_cache[i].character = NULL;
+    }
+}
+
+void invalidate_panel_cache(void) {
+    for (int i = 0; i < PANEL_CACHE_SLOTS; i++) {
+        panel_cache[i].character = NULL;
+    }
 }
 
 void print_attr_h(const int x, const int y, const attributes_t* attr_base, const attributes_t* attr_bonus) {
@@ -224,57 +331,57 @@ void print_attr_h(const int x, const int y, const attributes_t* attr_base, const
     int bonus_x = x + COLUMN1_OFFSET_H + 5;
 
     // strength
-    tb_printf(base_x, y, c_white, c_default, "[%d]", attr_base->strength);
+    frame_printf(base_x, y, c_white, c_default, "[%d]", attr_base->strength);
     if (attr_bonus->strength > 0) {
-        tb_printf(bonus_x, y, c_green, c_default, "+%d", attr_bonus->strength);
+        frame_printf(bonus_x, y, c_green, c_default, "+%d", attr_bonus->strength);
     } else if (attr_bonus->strength < 0) {
-        tb_printf(bonus_x, y, c_red, c_default, "%d", attr_bonus->strength);
+        frame_printf(bonus_x, y, c_red, c_default, "%d", attr_bonus->strength);
     } else {
-        tb_printf(bonus_x, y, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y, c_white, c_default, "-  ");
     }
     base_x += COLUMN_WIDTH_H;
     bonus_x += COLUMN_WIDTH_H + 2;
     // intelligence
-    tb_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->intelligence);
+    frame_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->intelligence);
     if (attr_bonus->intelligence > 0) {
-        tb_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->intelligence);
+        frame_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->intelligence);
     } else if (attr_bonus->intelligence < 0) {
-        tb_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->intelligence);
+        frame_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->intelligence);
     } else {
-        tb_printf(bonus_x, y, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y, c_white, c_default, "-  ");
     }
     base_x += COLUMN_WIDTH_H;
     bonus_x += COLUMN_WIDTH_H;
     // agility
-    tb_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->agility);
+    frame_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->agility);
     if (attr_bonus->agility > 0) {
-        tb_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->agility);
+        frame_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->agility);
     } else if (attr_bonus->agility < 0) {
-        tb_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->agility);
+        frame_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->agility);
     } else {
-        tb_printf(bonus_x, y, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y, c_white, c_default, "-  ");
     }
     base_x += COLUMN_WIDTH_H;
     bonus_x += COLUMN_WIDTH_H;
     // constitution
-    tb_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->constitution);
+    frame_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->constitution);
     if (attr_bonus->constitution > 0) {
-        tb_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->constitution);
+        frame_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->constitution);
     } else if (attr_bonus->constitution < 0) {
-        tb_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->constitution);
+        frame_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->constitution);
     } else {
-        tb_printf(bonus_x, y, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y, c_white, c_default, "-  ");
     }
     base_x += COLUMN_WIDTH_H;
     bonus_x += COLUMN_WIDTH_H;
     // luck
-    tb_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->luck);
+    frame_printf(base_x, y, c_white, c_default, "| [%d]", attr_base->luck);
     if (attr_bonus->luck > 0) {
-        tb_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->luck);
+        frame_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->luck);
     } else if (attr_bonus->luck < 0) {
-        tb_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->luck);
+        frame_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->luck);
     } else {
-        tb_printf(bonus_x, y, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y, c_white, c_default, "-  ");
     }
 }
 
@@ -291,54 +398,57 @@ void print_attr_v(const int x, int y, const attributes_t* attr_base, const attri
 
     const int bonus_x = x + 5;
     // strength
-    tb_printf(x, y, c_white, c_default, "[%d]", attr_base->strength);
+    frame_printf(x, y, c_white, c_default, "[%d]", attr_base->strength);
     if (attr_bonus->strength > 0) {
-        tb_printf(bonus_x, y++, c_green, c_default, "+%d", attr_bonus->strength);
+        frame_printf(bonus_x, y++, c_green, c_default, "+%d", attr_bonus->strength);
     } else if (attr_bonus->strength < 0) {
-        tb_printf(bonus_x, y++, c_red, c_default, "%d", attr_bonus->strength);
+        frame_printf(bonus_x, y++, c_red, c_default, "%d", attr_bonus->strength);
     } else {
-        tb_printf(bonus_x, y++, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y++, c_white, c_default, "-  ");
     }
     // intelligence
-    tb_printf(x, y, c_white, c_default, "[%d]", attr_base->intelligence);
+    frame_printf(x, y, c_white, c_default, "[%d]", attr_base->intelligence);
     if (attr_bonus->intelligence > 0) {
-        tb_printf(bonus_x, y++, c_green, c_default, "+%d ", attr_bonus->intelligence);
+        frame_printf(bonus_x, y++, c_green, c_default, "+%d ", attr_bonus->intelligence);
     } else if (attr_bonus->intelligence < 0) {
-        tb_printf(bonus_x, y++, c_red, c_default, "%d ", attr_bonus->intelligence);
+        frame_printf(bonus_x, y++, c_red, c_default, "%d ", attr_bonus->intelligence);
     } else {
-        tb_printf(bonus_x, y++, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y++, c_white, c_default, "-  ");
     }
     // agility
-    tb_printf(x, y, c_white, c_default, "[%d]", attr_base->agility);
+    frame_printf(x, y, c_white, c_default, "[%d]", attr_base->agility);
     if (attr_bonus->agility > 0) {
-        tb_printf(bonus_x, y++, c_green, c_default, "+%d ", attr_bonus->agility);
+        frame_printf(bonus_x, y++, c_green, c_default, "+%d ", attr_bonus->agility);
     } else if (attr_bonus->agility < 0) {
-        tb_printf(bonus_x, y++, c_red, c_default, "%d ", attr_bonus->agility);
+        frame_printf(bonus_x, y++, c_red, c_default, "%d ", attr_bonus->agility);
     } else {
-        tb_printf(bonus_x, y++, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y++, c_white, c_default, "-  ");
     }
     // constitution
-    tb_printf(x, y, c_white, c_default, "[%d]", attr_base->constitution);
+    frame_printf(x, y, c_white, c_default, "[%d]", attr_base->constitution);
     if (attr_bonus->constitution > 0) {
-        tb_printf(bonus_x, y++, c_green, c_default, "+%d ", attr_bonus->constitution);
+        frame_printf(bonus_x, y++, c_green, c_default, "+%d ", attr_bonus->constitution);
     } else if (attr_bonus->constitution < 0) {
-        tb_printf(bonus_x, y++, c_red, c_default, "%d ", attr_bonus->constitution);
+        frame_printf(bonus_x, y++, c_red, c_default, "%d ", attr_bonus->constitution);
     } else {
-        tb_printf(bonus_x, y++, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y++, c_white, c_default, "-  ");
     }
     // luck
-    tb_printf(x, y, c_white, c_default, "[%d]", attr_base->luck);
+    frame_printf(x, y, c_white, c_default, "[%d]", attr_base->luck);
     if (attr_bonus->luck > 0) {
-        tb_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->luck);
+        frame_printf(bonus_x, y, c_green, c_default, "+%d ", attr_bonus->luck);
     } else if (attr_bonus->luck < 0) {
-        tb_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->luck);
+        frame_printf(bonus_x, y, c_red, c_default, "%d ", attr_bonus->luck);
     } else {
-        tb_printf(bonus_x, y, c_white, c_default, "-  ");
+        frame_printf(bonus_x, y, c_white, c_default, "-  ");
     }
 }
 
 
 void update_character_output_local(void) {
+    // the cached panels contain the strings of the previous language
+    invalidate_panel_cache();
+
     for (int i = 0; i < MAX_CO_STRINGS; i++) {
         if (co_strings[i] != NULL) {
             free(co_strings[i]);
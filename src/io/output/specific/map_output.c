@@ -1,24 +1,117 @@
 #include "map_output.h"
 
-#include "../../../../termbox2/termbox2.h"
 #include "../../../logger/logger.h"
 #include "../../colors.h"
+#include "../common/common_output.h"
+#include "../frame/frame_buffer.h"
 
-void print_map(int x, int y, const parsed_map_t* map) {
-    RETURN_WHEN_NULL(map, , "Map Output", "Map is NULL");
+#include <stdlib.h>
 
-    if (x < 0 || y < 0) {
-        log_msg(WARNING, "Map Output", "Invalid anchor position: (%d, %d), set to (0, 0)", x, y);
-        x = 0;
-        y = 0;
+// the screen cell of every tile, drawing a tile is a single lookup and `frame_set_cell`
+static const frame_cell_t tile_cells[MAX_MAP_TILES] = {
+        [WALL] = {'#', TB_BLUE, TB_BLUE},
+        [FLOOR] = {' ', TB_WHITE, TB_BLACK},
+        [START_DOOR] = {'#', TB_GREEN, TB_BLACK},
+        [EXIT_DOOR] = {'#', TB_YELLOW, TB_BLACK},
+        [DOOR_KEY] = {'$', TB_YELLOW, TB_BLACK},
+        [LIFE_FOUNTAIN] = {'+', TB_RED, TB_BLACK},
+        [MANA_FOUNTAIN] = {'+', TB_BLUE, TB_BLACK},
+        [STAMINA_FOUNTAIN] = {'+', TB_GREEN, TB_BLACK},
+        [PLAYER] = {'@', TB_RED, TB_BLACK},
+        [ENEMY] = {'!', TB_WHITE, TB_RED},
+        [HIDDEN] = {' ', TB_WHITE, TB_WHITE}};
+
+/**
+ * Clears the screen area of the last rendered view.
+ *
+ * @param cache The render cache of the view.
+ */
+void clear_map_area(const map_render_cache_t* cache);
+
+map_render_cache_t* create_map_render_cache(void) {
+    map_render_cache_t* cache = malloc(sizeof(map_render_cache_t));
+    RETURN_WHEN_NULL(cache, NULL, "Map Output", "Failed to allocate memory for the render cache");
+    cache->capacity = 0;
+    cache->tiles = NULL;
+    cache->map = NULL;
+    cache->valid = 0;
+    return cache;
+}
+
+void destroy_map_render_cache(map_render_cache_t* cache) {
+    RETURN_WHEN_NULL(cache, , "Map Output", "In `destroy_map_render_cache` given cache is NULL")
+    free(cache->tiles);
+    free(cache);
+}
+
+void invalidate_map_render_cache(map_render_cache_t* cache) {
+    RETURN_WHEN_NULL(cache, , "Map Output", "In `invalidate_map_render_cache` given cache is NULL")
+    cache->valid = 0;
+}
+
+int render_map_view(map_render_cache_t* cache, const int x, const int y, const map_t* map, const int view_x,
+                    const int view_y, const int width, const int height) {
+    RETURN_WHEN_NULL(cache, -1, "Map Output", "Render cache is NULL");
+    RETURN_WHEN_NULL(map, -1, "Map Output", "Map is NULL");
+    RETURN_WHEN_TRUE(width <= 0 || height <= 0, -1, "Map Output", "Invalid view size %dx%d", width, height);
+
+    if (cache->valid && cache->map == map && cache->tiles_version == map->tiles_version &&
+        cache->player_pos.dx == map->player_pos.dx && cache->player_pos.dy == map->player_pos.dy &&
+        cache->anchor_x == x && cache->anchor_y == y && cache->view_x == view_x && cache->view_y == view_y &&
+        cache->width == width && cache->height == height) {
+        return 0;// a static scene, the screen still shows the map
     }
 
-    for (int i = 0; i < map->width; i++) {
-        for (int j = 0; j < map->height; j++) {
-            const parsed_map_tile_t tile = map->tiles[i * map->height + j];
-            tb_printf(x + i, y + j, tile.foreground_color, tile.background_color, "%c", tile.symbol);
+    //the cache holds the tiles per screen cell, so a scrolled view is still compared against the screen,
+    //only a moved or resized view leaves cells behind that aren't covered anymore
+    if (cache->anchor_x != x || cache->anchor_y != y || cache->width != width || cache->height != height) {
+        if (cache->valid) clear_map_area(cache);
+        cache->valid = 0;
+    }
+    if (width * height > cache->capacity) {
+        map_tile_t* tiles = malloc(width * height * sizeof(map_tile_t));
+        RETURN_WHEN_NULL(tiles, -1, "Map Output", "Failed to allocate memory for %dx%d tiles", width, height);
+        free(cache->tiles);
+        cache->tiles = tiles;
+        cache->capacity = width * height;
+        cache->valid = 0;
+    }
+
+    int written = 0;
+    for (int i = 0; i < width; i++) {
+        for (int j = 0; j < height; j++) {
+            map_tile_t tile = get_revealed_tile(map, view_x + i, view_y + j);
+            if (view_x + i == map->player_pos.dx && view_y + j == map->player_pos.dy) tile = PLAYER;
+
+            map_tile_t* drawn = &cache->tiles[i * height + j];
+            if (cache->valid && *drawn == tile) continue;
+            *drawn = tile;
+            const frame_cell_t* cell = &tile_cells[tile];
+            frame_set_cell(x + i, y + j, cell->ch, cell->fg, cell->bg);
+            written++;
         }
     }
 
-    tb_present();
+    cache->anchor_x = x;
+    cache->anchor_y = y;
+    cache->view_x = view_x;
+    cache->view_y = view_y;
+    cache->width = width;
+    cache->height = height;
+    cache->map = map;
+    cache->tiles_version = map->tiles_version;
+    cache->player_pos = map->player_pos;
+    cache->valid = 1;
+
+    if (written > 0) present_output();
+    return written;
+}
+
+void clear_map_area(const map_render_cache_t* cache) {
+    for (int i = 0; i < cache->width; i++) {
+        for (int j = 0; j < cache->height; j++) {
+            frame_set_cell(cache->anchor_x + i, cache->anchor_y + j, ' ', color_mapping[DEFAULT].value,
+                        color_mapping[DEFAULT].value);
+        }
+    }
 }
@@ -1,15 +1,65 @@
 #ifndef MAP_OUTPUT_H
 #define MAP_OUTPUT_H
 
-#include "../../../game_data/map/map_parser.h"
+#include "../../../game_data/map/map.h"
 
 /**
- * Prints the provided map on the console, starting from the specified anchor point.
+ * The tiles of the map view as they were last drawn into the back buffer. The back buffer keeps the cells between frames,
+ * so only the tiles that changed since the last frame have to be written again.
+ */
+typedef struct {
+    int anchor_x;              // screen position of the view
+    int anchor_y;
+    int view_x;                // map position of the top left tile of the view
+    int view_y;
+    int width;                 // dimensions of the view
+    int height;
+    int capacity;              // number of tiles the buffer can hold
+    map_tile_t* tiles;         // the drawn tiles per screen cell, index x * height + y
+    const map_t* map;          // the map that was drawn
+    unsigned int tiles_version;// tiles version of the map when it was drawn
+    vector2d_t player_pos;     // player position when the map was drawn
+    int valid;                 // 0 if the screen no longer shows the drawn tiles
+} map_render_cache_t;
+
+/**
+ * Creates an empty render cache, the first render draws the whole view.
+ *
+ * @return The render cache, or NULL if the allocation failed.
+ */
+map_render_cache_t* create_map_render_cache(void);
+
+/**
+ * Frees the render cache.
+ *
+ * @param cache The render cache to destroy.
+ */
+void destroy_map_render_cache(map_render_cache_t* cache);
+
+/**
+ * Marks the whole view as dirty, e.g. because the screen was cleared.
+ *
+ * @param cache The render cache.
+ */
+void invalidate_map_render_cache(map_render_cache_t* cache);
+
+/**
+ * Prints a section of the revealed map with the player on it, writing only the tiles that differ from the
+ * last render. The revealed tiles only change when the player moves or the tiles of the map change, so
+ * nothing is compared at all when neither the view, the player position nor the tiles version changed.
+ * The drawn tiles are kept per screen cell, so scrolling the view only writes the cells whose tile changed.
  *
- * @param x The x-coordinate of the anchor point where the map will be printed.
- * @param y The y-coordinate of the anchor point where the map will be printed.
- * @param map A pointer to the parsed map tile structure containing the tile symbols and their associated colors.
+ * @param cache The render cache.
+ * @param x The x-coordinate of the anchor point where the view is printed.
+ * @param y The y-coordinate of the anchor point where the view is printed.
+ * @param map The map.
+ * @param view_x The x-coordinate of the top left map tile of the view.
+ * @param view_y The y-coordinate of the top left map tile of the view.
+ * @param width The width of the view.
+ * @param height The height of the view.
+ * @return The number of written tiles, or -1 on failure.
  */
-void print_map(int x, int y, const parsed_map_t* map);
+int render_map_view(map_render_cache_t* cache, int x, int y, const map_t* map, int view_x, int view_y, int width,
+                    int height);
 
 #endif//MAP_OUTPUT_H
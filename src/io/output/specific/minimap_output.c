@@ -0,0 +1,219 @@
+#include "minimap_output.h"
+
+#include "../../../logger/logger.h"
+#include "../../colors.h"
+#include "../common/common_output.h"
+#include "../frame/frame_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BRAILLE_BLANK 0x2800// the braille characters are U+2800 plus the dot pattern
+#define DOTS_X 2            // dots per braille cell in each direction
+#define DOTS_Y 4
+
+// the bit of the braille dot pattern for each dot position, indexed [dot_x][dot_y]
+static const unsigned char braille_bits[DOTS_X][DOTS_Y] = {
+        {0x01, 0x02, 0x04, 0x40},
+        {0x08, 0x10, 0x20, 0x80}};
+
+/**
+ * Fits the minimap of the map into the given space and samples all tiles of the map.
+ *
+ * @param minimap The minimap.
+ * @param map The map.
+ * @param max_width The number of columns available on the screen.
+ * @param max_height The number of rows available on the screen.
+ * @return 0 on success, 1 on failure.
+ */
+int rebuild_minimap(minimap_t* minimap, const map_t* map, int max_width, int max_height);
+
+/**
+ * Samples the tiles of an area of the map into the dots. Dots are only set, since revealed tiles stay revealed
+ * until the map's reveal version changes. The changed braille cells are added to the dirty area.
+ *
+ * @param minimap The minimap.
+ * @param map The map.
+ * @param event The area of the map to sample.
+ */
+void sample_minimap_area(minimap_t* minimap, const map_t* map, reveal_event_t event);
+
+/**
+ * Writes a braille cell of the minimap to the frame.
+ *
+ * @param minimap The minimap.
+ * @param cell_x The x-coordinate of the braille cell.
+ * @param cell_y The y-coordinate of the braille cell.
+ */
+void draw_minimap_cell(const minimap_t* minimap, int cell_x, int cell_y);
+
+/**
+ * Adds a braille cell to the dirty area of the minimap.
+ */
+void mark_minimap_dirty(minimap_t* minimap, int cell_x, int cell_y);
+
+/**
+ * Clears the screen area of the last drawn minimap.
+ *
+ * @param minimap The minimap.
+ */
+void clear_minimap_area(const minimap_t* minimap);
+
+minimap_t* create_minimap(void) {
+    minimap_t* minimap = malloc(sizeof(minimap_t));
+    RETURN_WHEN_NULL(minimap, NULL, "Minimap Output", "Failed to allocate memory for the minimap");
+    memset(minimap, 0, sizeof(minimap_t));
+    return minimap;
+}
+
+void destroy_minimap(minimap_t* minimap) {
+    RETURN_WHEN_NULL(minimap, , "Minimap Output", "In `destroy_minimap` given minimap is NULL")
+    free(minimap->dots);
+    free(minimap);
+}
+
+void invalidate_minimap(minimap_t* minimap) {
+    RETURN_WHEN_NULL(minimap, , "Minimap Output", "In `invalidate_minimap` given minimap is NULL")
+    minimap->valid = 0;
+}
+
+int render_minimap(minimap_t* minimap, const int x, const int y, const map_t* map, const int max_width,
+                   const int max_height) {
+    RETURN_WHEN_NULL(minimap, -1, "Minimap Output", "Minimap is NULL");
+    RETURN_WHEN_NULL(map, -1, "Minimap Output", "Map is NULL");
+    RETURN_WHEN_TRUE(max_width <= 0 || max_height <= 0, -1, "Minimap Output", "Invalid minimap space %dx%d",
+                     max_width, max_height);
+
+    if (minimap->map != map || minimap->reveal_version != map->reveal_version || minimap->max_width != max_width ||
+        minimap->max_height != max_height || map->reveal_event_count - minimap->reveal_events > REVEAL_EVENT_SLOTS) {
+        if (minimap->valid) clear_minimap_area(minimap);
+        minimap->valid = 0;
+        RETURN_WHEN_TRUE(rebuild_minimap(minimap, map, max_width, max_height) != 0, -1, "Minimap Output",
+                         "Failed to rebuild the minimap");
+    }
+    //only the areas revealed since the last render are sampled again
+    for (; minimap->reveal_events != map->reveal_event_count; minimap->reveal_events++) {
+        sample_minimap_area(minimap, map, map->reveal_events[minimap->reveal_events & (REVEAL_EVENT_SLOTS - 1)]);
+    }
+    if (minimap->valid && (minimap->anchor_x != x || minimap->anchor_y != y)) {
+        clear_minimap_area(minimap);
+        minimap->valid = 0;
+    }
+    minimap->anchor_x = x;
+    minimap->anchor_y = y;
+
+    const vector2d_t player_cell = {map->player_pos.dx / (DOTS_X * minimap->scale),
+                                    map->player_pos.dy / (DOTS_Y * minimap->scale)};
+    int written = 0;
+    if (!minimap->valid) {
+        for (int i = 0; i < minimap->width; i++) {
+            for (int j = 0; j < minimap->height; j++) {
+                draw_minimap_cell(minimap, i, j);
+            }
+        }
+        written = minimap->width * minimap->height;
+    } else {
+        if (player_cell.dx != minimap->player_cell.dx || player_cell.dy != minimap->player_cell.dy) {
+            mark_minimap_dirty(minimap, minimap->player_cell.dx, minimap->player_cell.dy);
+            mark_minimap_dirty(minimap, player_cell.dx, player_cell.dy);
+        }
+        for (int i = minimap->dirty_x0; i <= minimap->dirty_x1; i++) {
+            for (int j = minimap->dirty_y0; j <= minimap->dirty_y1; j++) {
+                draw_minimap_cell(minimap, i, j);
+                written++;
+            }
+        }
+    }
+    //the player cell is drawn with the current position, so it is written after the dirty cells
+    minimap->player_cell = player_cell;
+    if (written > 0) draw_minimap_cell(minimap, player_cell.dx, player_cell.dy);
+
+    minimap->dirty_x0 = minimap->width;
+    minimap->dirty_y0 = minimap->height;
+    minimap->dirty_x1 = -1;
+    minimap->dirty_y1 = -1;
+    minimap->valid = 1;
+
+    if (written > 0) present_output();
+    return written;
+}
+
+int rebuild_minimap(minimap_t* minimap, const map_t* map, const int max_width, const int max_height) {
+    //the smallest scale at which the whole map fits into the space
+    int scale = 1;
+    while (scale * DOTS_X * max_width < map->width || scale * DOTS_Y * max_height < map->height) {
+        scale++;
+    }
+    const int width = (map->width + DOTS_X * scale - 1) / (DOTS_X * scale);
+    const int height = (map->height + DOTS_Y * scale - 1) / (DOTS_Y * scale);
+    if (width * height > minimap->capacity) {
+        unsigned char* dots = malloc(width * height);
+        RETURN_WHEN_NULL(dots, 1, "Minimap Output", "Failed to allocate memory for %dx%d cells", width, height);
+        free(minimap->dots);
+        minimap->dots = dots;
+        minimap->capacity = width * height;
+    }
+    memset(minimap->dots, 0, width * height);
+    minimap->max_width = max_width;
+    minimap->max_height = max_height;
+    minimap->width = width;
+    minimap->height = height;
+    minimap->scale = scale;
+    minimap->map = map;
+    minimap->reveal_version = map->reveal_version;
+    minimap->reveal_events = map->reveal_event_count;
+    minimap->valid = 0;
+
+    sample_minimap_area(minimap, map, (reveal_event_t) {0, 0, map->width, map->height});
+    return 0;
+}
+
+void sample_minimap_area(minimap_t* minimap, const map_t* map, const reveal_event_t event) {
+    const int x0 = event.x < 0 ? 0 : event.x;
+    const int y0 = event.y < 0 ? 0 : event.y;
+    const int x1 = event.x + event.width < map->width ? event.x + event.width : map->width;
+    const int y1 = event.y + event.height < map->height ? event.y + event.height : map->height;
+    const int dot_size = minimap->scale;
+
+    for (int tile_x = x0; tile_x < x1; tile_x++) {
+        const int dot_x = tile_x / dot_size;
+        for (int tile_y = y0; tile_y < y1; tile_y++) {
+            const map_tile_t tile = get_revealed_tile(map, tile_x, tile_y);
+            if (tile == HIDDEN || tile == WALL) continue;
+
+            const int dot_y = tile_y / dot_size;
+            const int cell_x = dot_x / DOTS_X;
+            const int cell_y = dot_y / DOTS_Y;
+            unsigned char* dots = &minimap->dots[cell_x * minimap->height + cell_y];
+            const unsigned char bit = braille_bits[dot_x % DOTS_X][dot_y % DOTS_Y];
+            if (*dots & bit) continue;
+            *dots |= bit;
+            mark_minimap_dirty(minimap, cell_x, cell_y);
+        }
+    }
+}
+
+void draw_minimap_cell(const minimap_t* minimap, const int cell_x, const int cell_y) {
+    const unsigned char dots = minimap->dots[cell_x * minimap->height + cell_y];
+    const int is_player = cell_x == minimap->player_cell.dx && cell_y == minimap->player_cell.dy;
+    //the player stands on a revealed tile, so the player's cell always has a dot
+    const uint32_t ch = dots == 0 ? ' ' : BRAILLE_BLANK + dots;
+    frame_set_cell(minimap->anchor_x + cell_x, minimap->anchor_y + cell_y, ch, is_player ? TB_RED : TB_WHITE,
+                   TB_BLACK);
+}
+
+void mark_minimap_dirty(minimap_t* minimap, const int cell_x, const int cell_y) {
+    if (cell_x < minimap->dirty_x0) minimap->dirty_x0 = cell_x;
+    if (cell_y < minimap->dirty_y0) minimap->dirty_y0 = cell_y;
+    if (cell_x > minimap->dirty_x1) minimap->dirty_x1 = cell_x;
+    if (cell_y > minimap->dirty_y1) minimap->dirty_y1 = cell_y;
+}
+
+void clear_minimap_area(const minimap_t* minimap) {
+    for (int i = 0; i < minimap->width; i++) {
+        for (int j = 0; j < minimap->height; j++) {
+            frame_set_cell(minimap->anchor_x + i, minimap->anchor_y + j, ' ', color_mapping[DEFAULT].value,
+                           color_mapping[DEFAULT].value);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef MINIMAP_OUTPUT_H
+#define MINIMAP_OUTPUT_H
+
+#include "../../../game_data/map/map.h"
+
+/**
+ * An overview of the whole map drawn with braille characters. Every braille cell has 2x4 dots and every dot
+ * stands for `scale` x `scale` tiles, it is set if one of these tiles is revealed and not a wall. The dots
+ * are kept between frames and only the areas of the map's reveal events are sampled again.
+ */
+typedef struct {
+    int anchor_x;               // screen position of the minimap
+    int anchor_y;
+    int max_width;              // space the minimap was fitted into, in screen cells
+    int max_height;
+    int width;                  // dimensions of the minimap in braille cells
+    int height;
+    int scale;                  // tiles per dot in each direction
+    int capacity;               // number of braille cells the buffer can hold
+    unsigned char* dots;        // the braille dot pattern per cell, index x * height + y
+    const map_t* map;           // the map the dots were sampled from
+    unsigned int reveal_version;// reveal version of the map when it was sampled
+    unsigned int reveal_events; // number of reveal events of the map that were applied
+    int dirty_x0;               // braille cells changed since the last render, empty if x0 > x1
+    int dirty_y0;
+    int dirty_x1;
+    int dirty_y1;
+    vector2d_t player_cell;     // braille cell of the player when the minimap was drawn
+    int valid;                  // 0 if the screen no longer shows the drawn minimap
+} minimap_t;
+
+/**
+ * Creates an empty minimap, the first render samples the whole map.
+ *
+ * @return The minimap, or NULL if the allocation failed.
+ */
+minimap_t* create_minimap(void);
+
+/**
+ * Frees the minimap.
+ *
+ * @param minimap The minimap to destroy.
+ */
+void destroy_minimap(minimap_t* minimap);
+
+/**
+ * Marks the whole minimap as not drawn, e.g. because the screen was cleared.
+ *
+ * @param minimap The minimap.
+ */
+void invalidate_minimap(minimap_t* minimap);
+
+/**
+ * Prints the minimap of the map with the player's cell highlighted. The whole map is only sampled when the map,
+ * its reveal version or the available space changed, or when more reveal events happened than the map keeps.
+ * Otherwise only the tiles of the new reveal events are sampled and only the changed braille cells are written.
+ *
+ * @param minimap The minimap.
+ * @param x The x-coordinate of the anchor point where the minimap is printed.
+ * @param y The y-coordinate of the anchor point where the minimap is printed.
+ * @param map The map.
+ * @param max_width The number of columns available on the screen.
+ * @param max_height The number of rows available on the screen.
+ * @return The number of written cells, or -1 on failure.
+ */
+int render_minimap(minimap_t* minimap, int x, int y, const map_t* map, int max_width, int max_height);
+
+#endif//MINIMAP_OUTPUT_H
@@ -0,0 +1,137 @@
+#include "perf_hud.h"
+
+#include "../../../logger/logger.h"
+#include "../common/common_output.h"
+#include "../frame/frame_buffer.h"
+#include "../frame/render_thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define HUD_WIDTH 32
+#define HUD_HEIGHT 5
+#define HUD_SAMPLES 128      // number of frames the statistics are calculated over
+#define HUD_REFRESH_FRAMES 13// the text is refreshed about twice per second, so it stays readable
+
+typedef struct {
+    int visible;
+    frame_buffer_t overlay;
+    long long frame_times[HUD_SAMPLES];// ring buffer of the last frame times
+    int sample_count;
+    int next_sample;
+    long long update_ns;               // sum of the update times since the last refresh
+    int frames_since_refresh;
+    unsigned long last_alloc_count;    // allocation count at the start of the current frame
+    unsigned long max_allocs;          // most allocations in a single frame since the last refresh
+} perf_hud_t;
+
+perf_hud_t perf_hud = {0};
+
+/**
+ * Compares two frame times for qsort.
+ */
+int compare_frame_times(const void* a, const void* b);
+
+/**
+ * Draws the current statistics into the overlay.
+ *
+ * @param pool The memory pool whose usage is shown.
+ */
+void draw_perf_hud(const memory_pool_t* pool);
+
+int init_perf_hud(void) {
+    perf_hud.overlay = (frame_buffer_t) {HUD_WIDTH, HUD_HEIGHT, HUD_WIDTH * HUD_HEIGHT, NULL};
+    perf_hud.overlay.cells = malloc(sizeof(frame_cell_t) * HUD_WIDTH * HUD_HEIGHT);
+    RETURN_WHEN_NULL(perf_hud.overlay.cells, 1, "Perf HUD", "Failed to allocate the overlay.")
+    perf_hud.visible = 0;
+    perf_hud.sample_count = 0;
+    perf_hud.next_sample = 0;
+    perf_hud.last_alloc_count = get_memory_pool_alloc_count();
+    return 0;
+}
+
+void shutdown_perf_hud(void) {
+    if (perf_hud.visible) set_frame_overlay(NULL, 0, 0);
+    free(perf_hud.overlay.cells);
+    perf_hud.overlay.cells = NULL;
+    perf_hud.visible = 0;
+}
+
+void toggle_perf_hud(void) {
+    RETURN_WHEN_NULL(perf_hud.overlay.cells, , "Perf HUD", "The HUD is not initialized.")
+    perf_hud.visible = !perf_hud.visible;
+    if (perf_hud.visible) {
+        // refresh in the next update, so the HUD shows up immediately
+        perf_hud.frames_since_refresh = HUD_REFRESH_FRAMES;
+    } else {
+        set_frame_overlay(NULL, 0, 0);
+        present_output();
+    }
+}
+
+void record_frame_time(const long long frame_ns) {
+    perf_hud.frame_times[perf_hud.next_sample] = frame_ns;
+    perf_hud.next_sample = (perf_hud.next_sample + 1) % HUD_SAMPLES;
+    if (perf_hud.sample_count < HUD_SAMPLES) perf_hud.sample_count++;
+}
+
+void update_perf_hud(const memory_pool_t* pool, const long long update_ns) {
+    const unsigned long alloc_count = get_memory_pool_alloc_count();
+    const unsigned long allocs = alloc_count - perf_hud.last_alloc_count;
+    perf_hud.last_alloc_count = alloc_count;
+    if (!perf_hud.visible || perf_hud.overlay.cells == NULL) return;
+
+    if (allocs > perf_hud.max_allocs) perf_hud.max_allocs = allocs;
+    perf_hud.update_ns += update_ns;
+    perf_hud.frames_since_refresh++;
+    if (perf_hud.frames_since_refresh < HUD_REFRESH_FRAMES) return;
+
+    draw_perf_hud(pool);
+    perf_hud.update_ns = 0;
+    perf_hud.frames_since_refresh = 0;
+    perf_hud.max_allocs = 0;
+
+    // placed every refresh, so the HUD follows the terminal size
+    const int x = get_frame_width() - HUD_WIDTH;
+    set_frame_overlay(&perf_hud.overlay, x < 0 ? 0 : x, 0);
+    present_output();
+}
+
+int compare_frame_times(const void* a, const void* b) {
+    const long long first = *(const long long*) a;
+    const long long second = *(const long long*) b;
+    return (first > second) - (first < second);
+}
+
+void draw_perf_hud(const memory_pool_t* pool) {
+    long long sorted[HUD_SAMPLES];
+    long long sum = 0;
+    const int count = perf_hud.sample_count;
+    memcpy(sorted, perf_hud.frame_times, sizeof(long long) * count);
+    for (int i = 0; i < count; i++) {
+        sum += sorted[i];
+    }
+    qsort(sorted, count, sizeof(long long), compare_frame_times);
+    const double avg_ms = count > 0 ? (double) sum / count / 1e6 : 0.0;
+    const double p99_ms = count > 0 ? (double) sorted[(count - 1) * 99 / 100] / 1e6 : 0.0;
+    const double update_ms = (double) perf_hud.update_ns / perf_hud.frames_since_refresh / 1e6;
+    const long long latency_ns = get_input_latency_ns();
+
+    frame_buffer_t* previous = redirect_frame_output(&perf_hud.overlay);
+    for (int i = 0; i < HUD_WIDTH * HUD_HEIGHT; i++) {
+        perf_hud.overlay.cells[i] = (frame_cell_t) {' ', TB_WHITE, TB_BLACK};
+    }
+    frame_printf(0, 0, TB_WHITE, TB_BLACK, " frame  avg %.2f p99 %.2f ms", avg_ms, p99_ms);
+    frame_printf(0, 1, TB_WHITE, TB_BLACK, " update %.3f ms", update_ms);
+    if (latency_ns < 0) {
+        frame_printf(0, 2, TB_WHITE, TB_BLACK, " input  -");
+    } else {
+        frame_printf(0, 2, TB_WHITE, TB_BLACK, " input  %.2f ms", (double) latency_ns / 1e6);
+    }
+    frame_printf(0, 3, TB_WHITE, TB_BLACK, " allocs %lu / frame", perf_hud.max_allocs);
+    if (pool != NULL) {
+        frame_printf(0, 4, TB_WHITE, TB_BLACK, " pool   %zu / %zu KiB", get_memory_pool_usage(pool) / 1024,
+                     pool->pool_size / 1024);
+    }
+    redirect_frame_output(previous);
+}
@@ -0,0 +1,38 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include "../../../memory/mem_mgmt.h"
+
+/**
+ * Allocates the overlay of the performance HUD. The HUD starts hidden.
+ *
+ * @return 0 on success, 1 on failure.
+ */
+int init_perf_hud(void);
+
+void shutdown_perf_hud(void);
+
+/**
+ * Shows or hides the performance HUD in the top right corner of the screen.
+ */
+void toggle_perf_hud(void);
+
+/**
+ * Records the time the game loop needed to produce a frame, from the start of the tick until the frame
+ * was published. The average and the 99th percentile are calculated over the last recorded frames.
+ *
+ * @param frame_ns The time in nanoseconds.
+ */
+void record_frame_time(long long frame_ns);
+
+/**
+ * Records the time spent in the update of the current game mode and refreshes the HUD a few times per second.
+ * Must be called between `begin_frame` and `end_frame`, the HUD is drawn over the published frame,
+ * so the output of the game modes isn't overwritten.
+ *
+ * @param pool The memory pool whose usage is shown.
+ * @param update_ns The time in nanoseconds spent in the update of the current mode.
+ */
+void update_perf_hud(const memory_pool_t* pool, long long update_ns);
+
+#endif//PERF_HUD_H
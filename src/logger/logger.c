@@ -6,6 +6,7 @@
 #include "ringbuffer.h"
 
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>
@@ -94,7 +95,8 @@ FILE* log_file = NULL;
 ring_buffer_t log_buffer;
 
 //states if the file writing thread is still running, if set to false, the thread terminates or is terminated
-bool logger_is_running = false;
+//log_msg is called from any thread and only reads this flag, the log file belongs to the writer thread
+atomic_bool logger_is_running = false;
 //the id of the used file
 int file_id = 0;
 
@@ -240,7 +242,7 @@ void init_logger(void) {
 }
 
 void log_msg(const log_level_t level, const char* module, const char* format, ...) {
-    if (log_file == NULL || !logger_is_running) {
+    if (!logger_is_running) {
         // logger is not initialized or not running
         return;
     }
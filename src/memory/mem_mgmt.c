@@ -2,8 +2,11 @@
 
 #include "../logger/logger.h"
 
+#include <stdatomic.h>
 #include <string.h>
 
+atomic_ulong alloc_count = 0;// successful allocations on all pools
+
 memory_pool_t* init_memory_pool(size_t size) {
     if (size < MIN_MEMORY_POOL_SIZE) {
         //set the size to the minimum
@@ -57,6 +60,7 @@ void* memory_pool_alloc(const memory_pool_t* pool, size_t size) {
             }
             //the remaining memory space is too small, so the current block will be used entirely
             current->active = 1;
+            alloc_count++;
             return (void*) (current + 1);// return pointer to user data
         }
         current = current->next;// move to the next block
@@ -122,6 +126,20 @@ void* memory_pool_realloc(const memory_pool_t* pool, void* ptr, size_t new_size)
     return new_ptr;
 }
 
+unsigned long get_memory_pool_alloc_count(void) {
+    return alloc_count;
+}
+
+size_t get_memory_pool_usage(const memory_pool_t* pool) {
+    RETURN_WHEN_NULL(pool, 0, "Memory", "In `get_memory_pool_usage` pool is NULL")
+
+    size_t used = 0;
+    for (const memory_block_t* current = pool->first; current != NULL; current = current->next) {
+        if (current->active) used += sizeof(memory_block_t) + current->size;
+    }
+    return used;
+}
+
 void shutdown_memory_pool(memory_pool_t* pool) {
     if (!pool) {
         log_msg(ERROR, "Memory", "Pool is NULL");
@@ -50,6 +50,19 @@ void memory_pool_free(const memory_pool_t* pool, void* ptr);
 
 void* memory_pool_realloc(const memory_pool_t* pool, void* ptr, size_t new_size);
 
+/**
+ * @return The number of successful allocations on all memory pools since the start of the program.
+ */
+unsigned long get_memory_pool_alloc_count(void);
+
+/**
+ * Sums up the memory of the active blocks of the given pool, including their block headers.
+ *
+ * @param pool the pool to inspect
+ * @return the used memory in bytes
+ */
+size_t get_memory_pool_usage(const memory_pool_t* pool);
+
 /**
  * Frees the allocated memory pool.
  * @param pool the pool to free
@@ -6,6 +6,11 @@ typedef struct {
     void (*func)(void);
 } thread_func_wrapper_t;
 
+typedef struct {
+    void (*func)(void*);
+    void* arg;
+} thread_arg_func_wrapper_t;
+
 #ifdef _WIN32
     #include <windows.h>
 
@@ -29,6 +34,32 @@ void start_simple_thread(void (*thread_func)(void)) {
     }
 }
 
+DWORD WINAPI thread_arg_wrapper(LPVOID arg) {
+    thread_arg_func_wrapper_t* wrapper_arg = (thread_arg_func_wrapper_t*) arg;
+    wrapper_arg->func(wrapper_arg->arg);
+    free(wrapper_arg);
+    return 0;
+}
+
+int start_joinable_thread(thread_t* thread, void (*thread_func)(void*), void* arg) {
+    thread_arg_func_wrapper_t* wrapper_arg = malloc(sizeof(thread_arg_func_wrapper_t));
+    if (!wrapper_arg) return 1;
+    wrapper_arg->func = thread_func;
+    wrapper_arg->arg = arg;
+
+    *thread = CreateThread(NULL, 0, thread_arg_wrapper, wrapper_arg, 0, NULL);
+    if (*thread == NULL) {
+        free(wrapper_arg);
+        return 1;
+    }
+    return 0;
+}
+
+void join_thread(thread_t thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
 #else
     #include <pthread.h>
 
@@ -51,4 +82,28 @@ void start_simple_thread(void (*thread_func)(void)) {
         free(arg);// Fehlerbehandlung
     }
 }
+
+void* thread_arg_wrapper(void* arg) {
+    thread_arg_func_wrapper_t* wrapper_arg = (thread_arg_func_wrapper_t*) arg;
+    wrapper_arg->func(wrapper_arg->arg);
+    free(wrapper_arg);
+    return NULL;
+}
+
+int start_joinable_thread(thread_t* thread, void (*thread_func)(void*), void* arg) {
+    thread_arg_func_wrapper_t* wrapper_arg = malloc(sizeof(thread_arg_func_wrapper_t));
+    if (!wrapper_arg) return 1;
+    wrapper_arg->func = thread_func;
+    wrapper_arg->arg = arg;
+
+    if (pthread_create(thread, NULL, thread_arg_wrapper, wrapper_arg) != 0) {
+        free(wrapper_arg);
+        return 1;
+    }
+    return 0;
+}
+
+void join_thread(const thread_t thread) {
+    pthread_join(thread, NULL);
+}
 #endif
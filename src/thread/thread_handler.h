@@ -1,6 +1,13 @@
 #ifndef THREAD_HANDLER_H
 #define THREAD_HANDLER_H
 
+#ifdef _WIN32
+typedef void* thread_t;// the windows HANDLE of the thread
+#else
+    #include <pthread.h>
+typedef pthread_t thread_t;
+#endif
+
 /**
  * Starts a new thread with the given function.
  * The thread will be detached, so it will run independently.
@@ -9,4 +16,21 @@
  */
 void start_simple_thread(void (*thread_func)(void));
 
+/**
+ * Starts a new thread with the given function and argument, that must be joined with `join_thread`.
+ *
+ * @param thread Pointer to the handle of the started thread.
+ * @param thread_func The function that will be executed in the thread.
+ * @param arg The argument passed to the function.
+ * @return 0 if the thread was started, 1 otherwise.
+ */
+int start_joinable_thread(thread_t* thread, void (*thread_func)(void*), void* arg);
+
+/**
+ * Waits until the given thread has finished and releases its resources.
+ *
+ * @param thread The handle of a thread started with `start_joinable_thread`.
+ */
+void join_thread(thread_t thread);
+
 #endif//THREAD_HANDLER_H
@@ -0,0 +1,165 @@
+#include "../src/game_data/map/map_bitboard.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define WIDTH 5
+#define HEIGHT 70// more than one word per column
+
+map_tile_t tiles[WIDTH * HEIGHT];
+
+void set_tile(const int x, const int y, const map_tile_t tile) {
+    tiles[x * HEIGHT + y] = tile;
+}
+
+void reset_tiles(void) {
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        tiles[i] = WALL;
+    }
+}
+
+void test_fill_and_count(void) {
+    reset_tiles();
+    set_tile(1, 1, FLOOR);
+    set_tile(1, 63, DOOR_KEY);
+    set_tile(1, 64, ENEMY);
+    set_tile(3, 69, FLOOR);
+
+    uint64_t bits[BITBOARD_SIZE(WIDTH, HEIGHT)];
+    bitboard_t open;
+    init_bitboard(&open, bits, WIDTH, HEIGHT);
+    fill_open_bitboard(&open, tiles);
+
+    assert(open.words == 2);
+    assert(count_bitboard(&open) == 4);
+    assert(get_bitboard_bit(&open, 1, 63) == 1);
+    assert(get_bitboard_bit(&open, 1, 64) == 1);
+    assert(get_bitboard_bit(&open, 2, 64) == 0);
+    assert(get_bitboard_bit(&open, -1, 0) == 0);
+
+    vector2d_t list[4];
+    assert(bitboard_to_list(&open, list, 4) == 4);
+    assert(list[2].dx == 1 && list[2].dy == 64);
+    assert(list[3].dx == 3 && list[3].dy == 69);
+    printf("test_fill_and_count: passed\n");
+}
+
+void test_neighbours_across_words(void) {
+    // a vertical corridor in column 2 crossing the word border, ending at y = 60 and y = 68
+    reset_tiles();
+    for (int y = 60; y <= 68; y++) {
+        set_tile(2, y, FLOOR);
+    }
+    set_tile(1, 64, FLOOR);// a side branch at the word border
+
+    uint64_t bits[4][BITBOARD_SIZE(WIDTH, HEIGHT)];
+    bitboard_t open;
+    bitboard_t counts[3];
+    init_bitboard(&open, bits[0], WIDTH, HEIGHT);
+    for (int i = 0; i < 3; i++) {
+        init_bitboard(&counts[i], bits[i + 1], WIDTH, HEIGHT);
+    }
+    fill_open_bitboard(&open, tiles);
+    count_neighbours_bitboard(&open, counts);
+
+    // (2, 64) has up, down and left open -> 3
+    assert(get_bitboard_bit(&counts[0], 2, 64) == 1);
+    assert(get_bitboard_bit(&counts[1], 2, 64) == 1);
+    assert(get_bitboard_bit(&counts[2], 2, 64) == 0);
+    // (2, 63) has up and down open -> 2
+    assert(get_bitboard_bit(&counts[0], 2, 63) == 0);
+    assert(get_bitboard_bit(&counts[1], 2, 63) == 1);
+
+    bitboard_t dead_ends;
+    init_bitboard(&dead_ends, bits[1], WIDTH, HEIGHT);
+    find_dead_ends_bitboard(&open, &dead_ends);
+    assert(count_bitboard(&dead_ends) == 3);
+    assert(get_bitboard_bit(&dead_ends, 2, 60) == 1);
+    assert(get_bitboard_bit(&dead_ends, 2, 68) == 1);
+    assert(get_bitboard_bit(&dead_ends, 1, 64) == 1);
+    printf("test_neighbours_across_words: passed\n");
+}
+
+void test_loop_candidates(void) {
+    // two horizontal corridors in row 1 and 3, separated by the walls in row 2
+    reset_tiles();
+    for (int x = 1; x <= 3; x++) {
+        set_tile(x, 1, FLOOR);
+        set_tile(x, 3, FLOOR);
+    }
+    // the vertical opposing pair (1, 5) - (1, 7) with the wall (1, 6) between
+    set_tile(1, 5, FLOOR);
+    set_tile(1, 7, FLOOR);
+
+    uint64_t bits[2][BITBOARD_SIZE(WIDTH, HEIGHT)];
+    bitboard_t open;
+    bitboard_t candidates;
+    init_bitboard(&open, bits[0], WIDTH, HEIGHT);
+    init_bitboard(&candidates, bits[1], WIDTH, HEIGHT);
+    fill_open_bitboard(&open, tiles);
+    find_loop_candidates_bitboard(&open, &candidates);
+
+    // the walls (1..3, 2) lay between row 1 and 3, their left and right neighbours are walls
+    assert(get_bitboard_bit(&candidates, 1, 2) == 1);
+    assert(get_bitboard_bit(&candidates, 2, 2) == 1);
+    assert(get_bitboard_bit(&candidates, 3, 2) == 1);
+    assert(get_bitboard_bit(&candidates, 1, 6) == 1);
+    // (1, 4) lies between (1, 3) and (1, 5)
+    assert(get_bitboard_bit(&candidates, 1, 4) == 1);
+    assert(count_bitboard(&candidates) == 5);
+
+    for (int x = 0; x < WIDTH; x++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            assert(is_loop_candidate(&open, x, y) == get_bitboard_bit(&candidates, x, y));
+        }
+    }
+    printf("test_loop_candidates: passed\n");
+}
+
+void test_cave_step(void) {
+    // a pseudo random pattern, compared against counting the 8 neighbours tile by tile
+    reset_tiles();
+    unsigned int state = 12345;
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        state = state * 1103515245 + 12345;
+        tiles[i] = state >> 16 & 1 ? FLOOR : WALL;
+    }
+
+    uint64_t bits[2][BITBOARD_SIZE(WIDTH, HEIGHT)];
+    bitboard_t walls_board;
+    bitboard_t next;
+    init_bitboard(&walls_board, bits[0], WIDTH, HEIGHT);
+    init_bitboard(&next, bits[1], WIDTH, HEIGHT);
+    const bitboard_t* walls = &walls_board;
+    for (int x = 0; x < WIDTH; x++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            set_bitboard_bit(walls, x, y, tiles[x * HEIGHT + y] == WALL);
+        }
+    }
+    step_cave_bitboard(walls, &next);
+
+    for (int x = 0; x < WIDTH; x++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            int expected = 1;
+            if (x > 0 && y > 0 && x < WIDTH - 1 && y < HEIGHT - 1) {
+                int count = 0;
+                for (int dx = -1; dx <= 1; dx++) {
+                    for (int dy = -1; dy <= 1; dy++) {
+                        if (dx != 0 || dy != 0) count += get_bitboard_bit(walls, x + dx, y + dy);
+                    }
+                }
+                expected = get_bitboard_bit(walls, x, y) ? count >= 4 : count >= 5;
+            }
+            assert(get_bitboard_bit(&next, x, y) == expected);
+        }
+    }
+    printf("test_cave_step: passed\n");
+}
+
+int main(void) {
+    test_fill_and_count();
+    test_neighbours_across_words();
+    test_loop_candidates();
+    test_cave_step();
+    return 0;
+}
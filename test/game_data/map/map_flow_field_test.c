@@ -0,0 +1,144 @@
+#include "../../../src/game_data/map/map_flow_field.h"
+#include "../../../src/game_data/map/map_generator.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define POOL_SIZE (4 * 1024 * 1024)
+#define MAP_WIDTH 39
+#define MAP_HEIGHT 19
+#define MAP_COUNT 50
+
+map_t* generate_floor(memory_pool_t* pool, const int floor_nr) {
+    map_t* map = memory_pool_alloc(pool, sizeof(map_t));
+    assert(map != NULL);
+    map->floor_nr = floor_nr;
+    map->width = MAP_WIDTH;
+    map->height = MAP_HEIGHT;
+    map->enemy_count = 4;
+    assert(generate_map(pool, map, 1) == 0);
+    return map;
+}
+
+// breadth first search over coordinates, so it can't share an indexing mistake with the flow field
+void reference_distances(const map_t* map, const vector2d_t source, int distances[MAP_WIDTH][MAP_HEIGHT]) {
+    static vector2d_t queue[MAP_WIDTH * MAP_HEIGHT];
+    for (int x = 0; x < MAP_WIDTH; x++) {
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            distances[x][y] = FLOW_UNREACHABLE;
+        }
+    }
+    if (get_hidden_tile(map, source.dx, source.dy) == WALL) return;
+
+    int head = 0;
+    int tail = 0;
+    distances[source.dx][source.dy] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+        const vector2d_t current = queue[head++];
+        for (int i = 0; i < 4; i++) {
+            const int x = current.dx + directions[i].dx;
+            const int y = current.dy + directions[i].dy;
+            if (x < 0 || y < 0 || x >= MAP_WIDTH || y >= MAP_HEIGHT) continue;
+            if (distances[x][y] != FLOW_UNREACHABLE || get_hidden_tile(map, x, y) == WALL) continue;
+            distances[x][y] = distances[current.dx][current.dy] + 1;
+            queue[tail++] = (vector2d_t) {x, y};
+        }
+    }
+}
+
+void assert_matches_reference(flow_field_t* field, const map_t* map, const vector2d_t source) {
+    static int expected[MAP_WIDTH][MAP_HEIGHT];
+    reference_distances(map, source, expected);
+    assert(update_flow_field(field, map, source) == 0);
+    for (int x = 0; x < MAP_WIDTH; x++) {
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            assert(get_flow_distance(field, x, y) == expected[x][y]);
+        }
+    }
+}
+
+void test_distances_match_bfs(memory_pool_t* pool) {
+    flow_field_t* field = create_flow_field(pool);
+    assert(field != NULL);
+
+    int door_sources = 0;
+    int border_row_sources = 0;
+    for (int seed = 0; seed < MAP_COUNT; seed++) {
+        srand(seed);
+        map_t* map = generate_floor(pool, 1 + seed % 3);
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            for (int y = 0; y < MAP_HEIGHT; y++) {
+                const map_tile_t tile = get_hidden_tile(map, x, y);
+                const int border_row = y == 0 || y == MAP_HEIGHT - 1;
+                // a neighbour index wrapping into the next column shows up for sources in the top and bottom rows
+                if (tile != START_DOOR && tile != EXIT_DOOR && !(border_row && tile != WALL)) continue;
+                assert_matches_reference(field, map, (vector2d_t) {x, y});
+                door_sources += tile == START_DOOR || tile == EXIT_DOOR;
+                border_row_sources += border_row;
+            }
+        }
+        destroy_map(pool, map);
+    }
+    assert(door_sources >= 2 * MAP_COUNT);
+    assert(border_row_sources > 0);
+
+    destroy_flow_field(field);
+    printf("test_distances_match_bfs: passed\n");
+}
+
+void test_border_rows_dont_wrap(memory_pool_t* pool) {
+    srand(2);
+    map_t* map = generate_floor(pool, 1);
+    flow_field_t* field = create_flow_field(pool);
+    assert(field != NULL);
+
+    // on generated maps the tile a wrapped index lands on is a border wall, so open both ends of each wrap
+    for (int x = 0; x < MAP_WIDTH; x++) {
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            set_hidden_tile(map, x, y, WALL);
+        }
+    }
+    set_hidden_tile(map, 5, 0, FLOOR);
+    set_hidden_tile(map, 4, MAP_HEIGHT - 1, FLOOR);
+    set_hidden_tile(map, 9, MAP_HEIGHT - 1, FLOOR);
+    set_hidden_tile(map, 10, 0, FLOOR);
+
+    assert_matches_reference(field, map, (vector2d_t) {5, 0});
+    assert(get_flow_distance(field, 4, MAP_HEIGHT - 1) == FLOW_UNREACHABLE);
+    assert_matches_reference(field, map, (vector2d_t) {9, MAP_HEIGHT - 1});
+    assert(get_flow_distance(field, 10, 0) == FLOW_UNREACHABLE);
+
+    destroy_flow_field(field);
+    destroy_map(pool, map);
+    printf("test_border_rows_dont_wrap: passed\n");
+}
+
+void test_wall_source(memory_pool_t* pool) {
+    srand(1);
+    map_t* map = generate_floor(pool, 1);
+    flow_field_t* field = create_flow_field(pool);
+    assert(field != NULL);
+
+    // the corners are always walls, nothing is reachable from them
+    assert(get_hidden_tile(map, 0, 0) == WALL);
+    assert_matches_reference(field, map, (vector2d_t) {0, 0});
+    assert(get_flow_distance(field, map->player_pos.dx, map->player_pos.dy) == FLOW_UNREACHABLE);
+
+    destroy_flow_field(field);
+    destroy_map(pool, map);
+    printf("test_wall_source: passed\n");
+}
+
+int main(void) {
+    memory_pool_t* pool = init_memory_pool(POOL_SIZE);
+    assert(pool != NULL);
+
+    test_distances_match_bfs(pool);
+    test_border_rows_dont_wrap(pool);
+    test_wall_source(pool);
+
+    shutdown_memory_pool(pool);
+    return 0;
+}
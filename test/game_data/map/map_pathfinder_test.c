@@ -0,0 +1,116 @@
+#include "../../../src/game_data/map/map_generator.h"
+#include "../../../src/game_data/map/map_pathfinder.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define POOL_SIZE (4 * 1024 * 1024)
+#define MAP_WIDTH 39
+#define MAP_HEIGHT 19
+
+map_t* generate_floor(memory_pool_t* pool) {
+    map_t* map = memory_pool_alloc(pool, sizeof(map_t));
+    assert(map != NULL);
+    map->floor_nr = 1;
+    map->width = MAP_WIDTH;
+    map->height = MAP_HEIGHT;
+    map->enemy_count = 4;
+    assert(generate_map(pool, map, 1) == 0);
+    return map;
+}
+
+void test_exit_not_revealed(memory_pool_t* pool) {
+    map_t* map = generate_floor(pool);
+    pathfinder_t* pathfinder = create_pathfinder(pool);
+    assert(pathfinder != NULL);
+
+    vector2d_t step;
+    assert(find_exit_step(pathfinder, map, &step) == 0);
+
+    destroy_pathfinder(pathfinder);
+    destroy_map(pool, map);
+    printf("test_exit_not_revealed: passed\n");
+}
+
+void test_walk_to_exit_door(memory_pool_t* pool) {
+    for (int seed = 0; seed < 20; seed++) {
+        srand(seed);
+        map_t* map = generate_floor(pool);
+        pathfinder_t* pathfinder = create_pathfinder(pool);
+        assert(pathfinder != NULL);
+        for (int x = 0; x < map->width; x++) {
+            for (int y = 0; y < map->height; y++) {
+                reveal_tile(map, x, y);
+            }
+        }
+
+        // follow the steps like the auto walk of the map mode does, every step moves to a neighbouring tile
+        int walked = 0;
+        vector2d_t step;
+        while (find_exit_step(pathfinder, map, &step)) {
+            assert(abs(step.dx - map->player_pos.dx) + abs(step.dy - map->player_pos.dy) == 1);
+            assert(get_hidden_tile(map, step.dx, step.dy) != WALL);
+            map->player_pos = step;
+            walked++;
+            assert(walked <= MAP_WIDTH * MAP_HEIGHT);
+        }
+        assert(walked > 0);
+        assert(get_hidden_tile(map, map->player_pos.dx, map->player_pos.dy) == EXIT_DOOR);
+
+        destroy_pathfinder(pathfinder);
+        destroy_map(pool, map);
+    }
+    printf("test_walk_to_exit_door: passed\n");
+}
+
+void test_known_path_after_reveal(memory_pool_t* pool) {
+    map_t* map = generate_floor(pool);
+    pathfinder_t* pathfinder = create_pathfinder(pool);
+    assert(pathfinder != NULL);
+
+    // a long revealed detour along the top and a short hidden corridor between the same tiles
+    for (int x = 0; x < MAP_WIDTH; x++) {
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            set_hidden_tile(map, x, y, WALL);
+            hide_tile(map, x, y);
+        }
+    }
+    for (int x = 1; x <= 10; x++) {
+        for (int y = 1; y <= 5; y++) {
+            if (y == 1 || x == 1 || x == 10 || y == 5) set_hidden_tile(map, x, y, FLOOR);
+            if (y == 1 || x == 1 || x == 10) reveal_tile(map, x, y);
+        }
+    }
+    const vector2d_t start = {1, 5};
+    const vector2d_t goal = {10, 5};
+    const vector2d_t* steps;
+    assert(find_path(pathfinder, map, start, goal, 1, &steps) == 17);
+
+    for (int x = 2; x <= 9; x++) {
+        reveal_tile(map, x, 5);
+    }
+    record_reveal_event(map, 2, 5, 8, 1);
+    assert(find_path(pathfinder, map, start, goal, 1, &steps) == 9);
+
+    // replacing the revealed tiles gives the map a new reveal version
+    for (int x = 2; x <= 9; x++) {
+        hide_tile(map, x, 5);
+    }
+    reset_reveal_events(map);
+    assert(find_path(pathfinder, map, start, goal, 1, &steps) == 17);
+
+    destroy_pathfinder(pathfinder);
+    destroy_map(pool, map);
+    printf("test_known_path_after_reveal: passed\n");
+}
+
+int main(void) {
+    memory_pool_t* pool = init_memory_pool(POOL_SIZE);
+    assert(pool != NULL);
+    test_exit_not_revealed(pool);
+    test_walk_to_exit_door(pool);
+    test_known_path_after_reveal(pool);
+    shutdown_memory_pool(pool);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "../../src/game_data/ability/ability.h"
+#include "../../src/game_data/map/map_compression.h"
+#include "../../src/game_data/map/map_generator.h"
+#include "../../src/game_data/map/map_revealer.h"
+#include "../../src/game_data/save_file_handler.h"
+#include "../../src/io/local/local_handler.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define POOL_SIZE (16 * 1024 * 1024)
+#define FLOOR_COUNT (FLOOR_CACHE_CAPACITY + 2)// more floors than the cache keeps in memory
+
+map_t* generate_floor(memory_pool_t* pool, const int floor_nr) {
+    map_t* map = memory_pool_alloc(pool, sizeof(map_t));
+    assert(map != NULL);
+    map->floor_nr = floor_nr;
+    map->width = 79;// larger than one block of the save file handler, so packed floors are decoded in blocks
+    map->height = 39;
+    map->enemy_count = 4;
+    assert(generate_map(pool, map, 1) == 0);
+    assert(reveal_map_shadowcast(map, 3) == 0);
+    return map;
+}
+
+void test_load_more_floors_than_cached(memory_pool_t* pool) {
+    game_state_t game_state = {
+            .max_floors = FLOOR_COUNT,
+            .active_map_index = 0,
+            .floors = create_floor_cache(pool),
+            .player = create_empty_character(0)};
+    assert(game_state.floors != NULL && game_state.player != NULL);
+    game_state.player->name = strdup("Tester");
+    map_tile_t* generated_tiles[FLOOR_COUNT];
+    for (int i = 0; i < FLOOR_COUNT; i++) {
+        map_t* map = generate_floor(pool, i + 1);
+        const size_t tiles_size = map->width * map->height * sizeof(map_tile_t);
+        generated_tiles[i] = malloc(tiles_size);
+        assert(generated_tiles[i] != NULL);
+        memcpy(generated_tiles[i], map->hidden_tiles, tiles_size);
+        assert(add_floor(game_state.floors, map) == i);
+    }
+    assert(save_game_state(SLOT_5, &game_state) == 0);
+
+    destroy_character(game_state.player);
+    game_state.player = NULL;
+    game_state.active_map_index = -1;
+    assert(load_game_state(SLOT_5, pool, &game_state) == 0);
+    assert(game_state.max_floors == FLOOR_COUNT);
+    assert(game_state.active_map_index == 0);
+
+    // the active floor is the first one, all later floors were added after it
+    const map_t* active = get_floor(game_state.floors, game_state.active_map_index);
+    assert(active != NULL);
+    assert(active->floor_nr == 1);
+    assert(active->packed_tiles == NULL && active->hidden_tiles != NULL);
+    assert(get_revealed_tile(active, active->player_pos.dx, active->player_pos.dy) != HIDDEN);
+
+    // the evicted floors were saved from their packed tiles
+    for (int i = 0; i < FLOOR_COUNT; i++) {
+        map_t* map = get_floor(game_state.floors, i);
+        assert(map != NULL && unpack_map(pool, map) == 0);
+        assert(memcmp(map->hidden_tiles, generated_tiles[i], map->width * map->height * sizeof(map_tile_t)) == 0);
+        free(generated_tiles[i]);
+    }
+
+    destroy_character(game_state.player);
+    destroy_floor_cache(game_state.floors);
+    printf("test_load_more_floors_than_cached: passed\n");
+}
+
+int main(void) {
+    srand(42);
+    // the save file and the evicted floors are written to a temporary directory, not into the working directory
+    char temp_dir[] = "/tmp/save_file_handler_test_XXXXXX";
+    assert(mkdtemp(temp_dir) != NULL);
+    set_save_directory(temp_dir);
+    set_floor_cache_directory(temp_dir);
+
+    memory_pool_t* pool = init_memory_pool(POOL_SIZE);
+    assert(pool != NULL);
+    // characters need the ability table, which reads the local strings from the resources
+    assert(init_local_handler(LANGE_EN) == 0);
+    assert(init_ability_table(pool) != NULL);
+
+    test_load_more_floors_than_cached(pool);
+
+    destroy_ability_table(pool);
+    shutdown_local_handler();
+    shutdown_memory_pool(pool);
+
+    char save_file_path[1024];
+    snprintf(save_file_path, sizeof(save_file_path), "%s/save_file_5.sav", temp_dir);
+    assert(remove(save_file_path) == 0);
+    assert(rmdir(temp_dir) == 0);
+    return 0;
+}
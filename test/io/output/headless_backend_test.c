@@ -0,0 +1,121 @@
+#include "../../../src/io/output/backend/headless_backend.h"
+#include "../../../src/io/output/common/common_output.h"
+#include "../../../src/io/output/frame/frame_buffer.h"
+#include "../../../src/io/output/frame/render_thread.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define WIDTH 16
+#define HEIGHT 8
+
+char dump[4096];
+
+const char* dump_text(const headless_backend_t* backend) {
+    FILE* file = tmpfile();
+    assert(file != NULL);
+    assert(dump_headless_text(backend, file) == 0);
+    rewind(file);
+    const size_t length = fread(dump, 1, sizeof(dump) - 1, file);
+    dump[length] = '\0';
+    fclose(file);
+    return dump;
+}
+
+void test_text_and_menu(headless_backend_t* backend) {
+    char* options[] = {"Start", "Quit"};
+    const Menu menu = {
+            .title = "Menu",
+            .options = options,
+            .option_count = 2,
+            .selected_index = 1,
+            .tailing_text = "[Esc]",
+            .args = {ACTIVE, BLACK, WHITE, WHITE, DEFAULT, 5},
+            .vtable = NULL};
+
+    clear_screen();
+    print_text(1, 0, RED, DEFAULT, "Hällo");
+    print_simple_menu(1, 1, &menu);
+
+    const char* expected = " Hällo          \n"
+                           " Menu           \n"
+                           "   Start        \n"
+                           " > Quit         \n"
+                           "                \n"
+                           "                \n"
+                           " [Esc]          \n"
+                           "                \n";
+    assert(strcmp(dump_text(backend), expected) == 0);
+
+    const frame_cell_t* umlaut = get_headless_cell(backend, 2, 0);
+    assert(umlaut->ch == 0xe4 && umlaut->fg == TB_RED);
+    const frame_cell_t* selected = get_headless_cell(backend, 1, 3);
+    assert(selected->ch == '>' && selected->fg == TB_BLACK && selected->bg == TB_WHITE);
+    assert(get_headless_cell(backend, WIDTH, 0) == NULL);
+    printf("test_text_and_menu: passed\n");
+}
+
+void test_frame_is_published_once(headless_backend_t* backend) {
+    const int before = backend->frames_written;
+    begin_frame();
+    clear_screen();
+    print_text(0, 0, DEFAULT, DEFAULT, "a");
+    clear_line(0, 0, WIDTH);
+    assert(backend->frames_written == before);
+    end_frame();
+    assert(backend->frames_written == before + 1);
+    assert(get_headless_cell(backend, 0, 0)->ch == ' ');
+
+    // nothing written, nothing published
+    begin_frame();
+    end_frame();
+    assert(backend->frames_written == before + 1);
+    printf("test_frame_is_published_once: passed\n");
+}
+
+void test_render_thread(headless_backend_t* backend) {
+    assert(start_render_thread() == 0);
+    begin_frame();
+    print_text(0, 7, GREEN, DEFAULT, "thread");
+    end_frame();
+    stop_render_thread();// writes the pending frame before it returns
+
+    assert(get_headless_cell(backend, 0, 7)->ch == 't');
+    assert(get_headless_cell(backend, 5, 7)->fg == TB_GREEN);
+    printf("test_render_thread: passed\n");
+}
+
+void test_ppm_dump(const headless_backend_t* backend) {
+    FILE* file = tmpfile();
+    assert(file != NULL);
+    assert(dump_headless_ppm(backend, file) == 0);
+
+    int width, height, max;
+    rewind(file);
+    assert(fscanf(file, "P6 %d %d %d", &width, &height, &max) == 3);
+    assert(width % WIDTH == 0 && height % HEIGHT == 0 && max == 255);
+    fgetc(file);// the single whitespace after the header
+    const long data_start = ftell(file);
+    fseek(file, 0, SEEK_END);
+    assert(ftell(file) - data_start == (long) width * height * 3);
+    fclose(file);
+    printf("test_ppm_dump: passed\n");
+}
+
+int main(void) {
+    headless_backend_t* backend = create_headless_backend(WIDTH, HEIGHT);
+    assert(backend != NULL);
+    set_output_backend(&backend->base);
+    assert(init_frame_buffer(WIDTH, HEIGHT) == 0);
+
+    test_text_and_menu(backend);
+    test_frame_is_published_once(backend);
+    test_render_thread(backend);
+    test_ppm_dump(backend);
+
+    shutdown_frame_buffer();
+    set_output_backend(NULL);
+    destroy_headless_backend(backend);
+    return 0;
+}